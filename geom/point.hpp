@@ -2,15 +2,18 @@
 
 #include "../prelude.hpp"
 
+#include "../struct/smat.hpp"
 #include "../struct/vec.hpp"
 #include "../wrapper/../wrapper/dbl.hpp"
 
+#include <type_traits>
+
 namespace pcl {
-template <int DIM>
-using point = coord<DIM>;
+template <int DIM, typename T = dbl>
+using point = coord<DIM, T>;
 
-template <int DIM>
-dbl distance(point<DIM> const &a, point<DIM> const &b) {
+template <int DIM, typename T>
+dbl distance(point<DIM, T> const &a, point<DIM, T> const &b) {
     return (a - b).length();
 }
 
@@ -26,25 +29,28 @@ enum class vecarg {
 };
 
 // only works when on the same plane.
-template <int DIM>
-vecarg vecarg_of_vecs(vec<DIM> const &a, vec<DIM> const &b) {
+template <int DIM, typename T>
+vecarg vecarg_of_vecs(vec<DIM, T> const &a, vec<DIM, T> const &b) {
     if (a == b) return vecarg::same;
     if (a.length() == 0) return vecarg::a_zero;
     if (b.length() == 0) return vecarg::b_zero;
 
     auto c = cross(a, b);
-    dbl p  = c[0] != 0 ? c[0] : c[1] != 0 ? c[1] : c[2];
-    dbl d  = dot(a, b);
-    if (p > 0) return vecarg::counterclock;
-    if (p < 0) return vecarg::clock;
-    if (d < 0) return vecarg::opposite;
-    if (a.length() < b.length()) return vecarg::b_longer;
+    T p    = c[0] != T(0) ? c[0] : c[1] != T(0) ? c[1] : c[2];
+    T d    = dot(a, b);
+    if (p > T(0)) return vecarg::counterclock;
+    if (p < T(0)) return vecarg::clock;
+    if (d < T(0)) return vecarg::opposite;
+    // 整数型なら長さの二乗で比べ、 sqrt の誤差を避ける。
+    bool shorter = std::is_integral<T>::value ? a.norm2() < b.norm2()
+                                              : a.length() < b.length();
+    if (shorter) return vecarg::b_longer;
     return vecarg::b_shorter;
 }
 
-template <int DIM>
-vecarg vecarg_of_points(point<DIM> const &x, point<DIM> const &a,
-                        point<DIM> const &b) {
+template <int DIM, typename T>
+vecarg vecarg_of_points(point<DIM, T> const &x, point<DIM, T> const &a,
+                        point<DIM, T> const &b) {
     return vecarg_of_vecs(a - x, b - x);
 }
 
@@ -56,19 +62,20 @@ bool is_rot_same(vecarg a, vecarg b) {
     return static_cast<int>(a) * static_cast<int>(b) == 1;
 }
 
-bool on_plane(point<2> const &, point<2> const &, point<2> const &,
-              point<2> const &) {
+template <typename T>
+bool on_plane(point<2, T> const &, point<2, T> const &, point<2, T> const &,
+              point<2, T> const &) {
     return true;
 }
 
-bool on_plane(point<3> const &a, point<3> b, point<3> c, point<3> d) {
+template <typename T>
+bool on_plane(point<3, T> const &a, point<3, T> b, point<3, T> c,
+              point<3, T> d) {
     b -= a, c -= a, d -= a;
 
-    mat<dbl> coords = {
-        {b[0], b[1], b[2]},
-        {c[0], c[1], c[2]},
-        {d[0], d[1], d[2]},
-    };
+    // 3 x 3 の行列式なので、ヒープを使わない smat で計算する。 T が整数型な
+    // ら誤差なしで判定できる。
+    auto coords = smat<T, 3>::from_rows({b, c, d});
 
     return coords.det() == 0;
 }
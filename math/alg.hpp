@@ -2,39 +2,90 @@
 
 #include "../prelude.hpp"
 
+#include <cassert>
 #include <cmath>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace pcl {
+
+/**
+ * @brief 最大公約数 (binary GCD)
+ * @details Stein のアルゴリズム。共通の 2 の冪を __builtin_ctzll でまとめて
+ * 取り除いてから、奇数同士の差をとっては 2 で割り切れるだけ割る、を繰り返す。
+ * 剰余演算を一切使わないので、 Euclid の互除法より速い。負の数は絶対値をとっ
+ * て扱い、戻り値は常に非負になる。 gcd(0, 0) = 0 。
+ */
 template <typename T>
 constexpr T gcd(T a, T b) {
-    return b == 0 ? a : gcd(b, a % b);
+    using U = typename std::make_unsigned<T>::type;
+    U x = a < 0 ? -static_cast<U>(a) : static_cast<U>(a);
+    U y = b < 0 ? -static_cast<U>(b) : static_cast<U>(b);
+    if (x == 0) return y;
+    if (y == 0) return x;
+
+    int shift = __builtin_ctzll(x | y);
+    x >>= __builtin_ctzll(x);
+    do {
+        y >>= __builtin_ctzll(y);
+        if (x > y) {
+            U t = x;
+            x   = y;
+            y   = t;
+        }
+        y -= x;
+    } while (y != 0);
+    return x << shift;
 }
 
+/// 最小公倍数。どちらかが 0 なら 0 。
 template <typename T>
 constexpr T lcm(T a, T b) {
+    if (a == 0 || b == 0) return 0;
     return a / gcd(a, b) * b;
 }
 
+/**
+ * @brief 拡張ユークリッドの互除法
+ * @return tuple<gcd, x, y> 。 a * x + b * y = gcd を満たす。
+ * @details 再帰せず、 (a, 1, 0) と (b, 0, 1) の二行に対して行基本変形を繰り
+ * 返す形で計算する。
+ */
 template <typename T>
-// tuple<x, y, gcd>
 constexpr std::tuple<T, T, T> extgcd(T a, T b) {
-    if (b == 0) {
-        return std::make_tuple(a, 1, 0);
-    } else {
-        T gcd, xd, yd;
-        std::tie(gcd, xd, yd) = extgcd(b, a % b);
-        return std::make_tuple(gcd, yd, xd - (a / b) * yd);
+    T x0 = 1, y0 = 0, x1 = 0, y1 = 1;
+    while (b != 0) {
+        T q = a / b, t = a - q * b;
+        a = b, b = t;
+        t = x0 - q * x1, x0 = x1, x1 = t;
+        t = y0 - q * y1, y0 = y1, y1 = t;
     }
+    return std::make_tuple(a, x0, y0);
+}
+
+/**
+ * @brief a の法 m における逆元を求める。
+ * @return a * x ≡ 1 (mod m) を満たす 0 <= x < m 。
+ * @details a と m は互いに素でなければならない。法 m は素数でなくてもよい。
+ */
+constexpr ll inv_mod(ll a, ll m) {
+    a %= m;
+    if (a < 0) a += m;
+    auto t = extgcd(a, m);
+    assert(std::get<0>(t) == 1);
+    ll x = std::get<1>(t) % m;
+    return x < 0 ? x + m : x;
 }
 
 /// verified with aoj:0009
+/// N 以下の素数を全て求める。最小素因数なども欲しければ linear_sieve を使う。
 template <typename T>
 std::vector<T> sieve(T N) {
     std::vector<T> res;
-    std::vector<bool> is_not_prime(N);
+    // vector<bool> は一ビットごとの読み書きになって遅いので char で持つ。
+    std::vector<char> is_not_prime(N + 1);
     for (T i = 2; i <= N; i++) {
         if (is_not_prime[i]) continue;
         res.push_back(i);
@@ -43,25 +94,230 @@ std::vector<T> sieve(T N) {
     return res;
 }
 
+/**
+ * @brief x^n を繰り返し二乗法で求める。
+ * @details T は 1 から構築でき、 *= が定義されていなければならない。指数が大
+ * きい場合や、行列・アフィン変換などの冪は pow<Monoid>() を使う。
+ */
 template <typename T>
-constexpr T pow(T x, int n) {
+constexpr typename std::enable_if<std::is_constructible<T, int>::value,
+                                  T>::type
+pow(T x, int n) {
     T res = 1;
     while (n > 0) {
         if (n & 1) res *= x;
-        x *= x;
         n >>= 1;
+        // 最後の二乗は使われないので、溢れないように省く。
+        if (n > 0) x *= x;
+    }
+    return res;
+}
+
+/**
+ * @brief モノイドの元 x の n 乗を繰り返し二乗法で求める。
+ * @param[in] x 底
+ * @param[in] n 指数 (64 bit)
+ * @details pow<monoid::mul<mint>>(x, n) や pow<monoid::affine<ll>>(f, n) の
+ * ように、モノイドを明示して呼ぶ。 op() の結果はそのままムーブ代入されるの
+ * で、大きな値でも不要なコピーは起こらない。最後の不要な二乗も省く。
+ */
+template <typename Monoid>
+typename Monoid::value_type pow(typename Monoid::value_type x, ull n) {
+    typename Monoid::value_type res = Monoid::id();
+    while (n > 0) {
+        if (n & 1) res = Monoid::op(res, x);
+        n >>= 1;
+        if (n > 0) x = Monoid::op(x, x);
     }
     return res;
 }
 
+/// a * b mod m (a, b < m) 。 m > 2^32 なら 128 bit の中間値を使う。
+constexpr ull mul_mod(ull a, ull b, ull m) {
+    if (m <= (1ull << 32)) return a * b % m;
+    return static_cast<ull>(static_cast<__uint128_t>(a) * b % m);
+}
+
+/// a^e mod m を繰り返し二乗法で計算する。
+constexpr ull pow_mod(ull a, ull e, ull m) {
+    ull res = 1 % m;
+    a %= m;
+    while (e > 0) {
+        if (e & 1) res = mul_mod(res, a, m);
+        a = mul_mod(a, a, m);
+        e >>= 1;
+    }
+    return res;
+}
+
+/**
+ * @brief 素数判定 (決定的 Miller-Rabin)
+ * @details 小さい素数で試し割りしたあと、 64 bit の範囲で誤判定しないことが
+ * 知られている底の組で Miller-Rabin 判定を行う。 n < 2^32 なら底は
+ * {2, 7, 61} で十分で、 mul_mod() も 64 bit の乗算で済む。全て constexpr な
+ * ので、コンパイル時定数の判定にもそのまま使える。計算量は O(log n) 。
+ */
 template <typename T>
 constexpr bool is_prime(T val) {
-    // msvc fails if use sqrt(val) instead of val
-    // maybe msvc has no constexpr sqrt function.
-    for (T i = 2; i < val; i++) {
-        if (val % i == 0) return false;
+    if (val < 2) return false;
+    ull n = static_cast<ull>(val);
+
+    ull const small[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    for (ull p : small) {
+        if (n % p == 0) return n == p;
+    }
+    // 37 以下の素因数をもたない 37^2 未満の数は素数。
+    if (n < 37 * 37) return true;
+
+    ull d = n - 1;
+    int s = 0;
+    while (d % 2 == 0) d /= 2, s++;
+
+    ull const bases32[] = {2, 7, 61};
+    ull const bases64[] = {2,      325,     9375,      28178,
+                           450775, 9780504, 1795265022};
+    bool const is32     = n < (1ull << 32);
+    ull const *bases    = is32 ? bases32 : bases64;
+    int const num_bases = is32 ? 3 : 7;
+    for (int i = 0; i < num_bases; i++) {
+        ull a = bases[i] % n;
+        if (a == 0) continue;
+        ull x = pow_mod(a, d, n);
+        if (x == 1 || x == n - 1) continue;
+        bool composite = true;
+        for (int r = 1; r < s && composite; r++) {
+            x = mul_mod(x, x, n);
+            if (x == n - 1) composite = false;
+        }
+        if (composite) return false;
     }
     return true;
 }
 
+/**
+ * @brief 素数 p の原始根を一つ求める。
+ * @details g が原始根であることは、 p - 1 の全ての素因数 q について
+ * g^((p-1)/q) != 1 であることと同値なので、小さい g から順に試す。 p - 1 の素
+ * 因数分解は試し割りで行う。
+ */
+constexpr ll primitive_root(ll p) {
+    if (p == 2) return 1;
+    ll factors[64] = {};
+    int count = 0;
+    ll x      = p - 1;
+    for (ll q = 2; q * q <= x; q++) {
+        if (x % q != 0) continue;
+        factors[count++] = q;
+        while (x % q == 0) x /= q;
+    }
+    if (x > 1) factors[count++] = x;
+
+    for (ll g = 2;; g++) {
+        bool ok = true;
+        for (int i = 0; i < count && ok; i++) {
+            if (pow_mod(g, (p - 1) / factors[i], p) == 1) ok = false;
+        }
+        if (ok) return g;
+    }
+}
+
+/**
+ * @brief 素数 p を法とする平方根 (Tonelli-Shanks)
+ * @return x^2 ≡ a (mod p) を満たす 0 <= x < p の一つ。なければ -1 。
+ * @details p - 1 = q 2^s (q は奇数) と分解し、 a^((q+1)/2) から始めて、誤差
+ * の位数を平方非剰余 z の冪で一段ずつ落としていく。計算量は O(log^2 p) 。
+ */
+inline ll sqrt_mod(ll a, ll p) {
+    a %= p;
+    if (a < 0) a += p;
+    if (a == 0 || p == 2) return a;
+    if (pow_mod(a, (p - 1) / 2, p) != 1) return -1;
+
+    ll q = p - 1;
+    int s = 0;
+    while (q % 2 == 0) q /= 2, s++;
+    ll z = 2;
+    while (pow_mod(z, (p - 1) / 2, p) != static_cast<ull>(p - 1)) z++;
+
+    ll m = s;
+    ll c = pow_mod(z, q, p);
+    ll t = pow_mod(a, q, p);
+    ll x = pow_mod(a, (q + 1) / 2, p);
+    while (t != 1) {
+        // t^(2^i) = 1 となる最小の i を探す。
+        ll i = 0, u = t;
+        while (u != 1) u = mul_mod(u, u, p), i++;
+        ll b = c;
+        for (ll j = 0; j < m - i - 1; j++) b = mul_mod(b, b, p);
+        m = i;
+        c = mul_mod(b, b, p);
+        t = mul_mod(t, c, p);
+        x = mul_mod(x, b, p);
+    }
+    return x;
+}
+
+/**
+ * @brief 中国剰余定理 - 連立合同式 x ≡ r[i] (mod m[i]) を解く。
+ * @return (x, M) 。 M は m たちの最小公倍数で、解は x (mod M) 、
+ * 0 <= x < M 。解がなければ (0, 0) 。
+ * @details 法は互いに素でなくてもよい。式を一本ずつマージしていく。 M が ll
+ * に収まる限り、途中の積は 128 bit で計算するので溢れない。
+ */
+inline std::pair<ll, ll> crt(std::vector<ll> const &r,
+                             std::vector<ll> const &m) {
+    assert(r.size() == m.size());
+    ll x = 0, M = 1;
+    for (int i = 0; i < static_cast<int>(r.size()); i++) {
+        assert(m[i] >= 1);
+        ll ri = r[i] % m[i];
+        if (ri < 0) ri += m[i];
+
+        // x + M * t ≡ ri (mod m[i]) を t について解く。
+        ll g, p, q;
+        std::tie(g, p, q) = extgcd(M, m[i]);
+        if ((ri - x) % g != 0) return std::make_pair(0, 0);
+        ll mg = m[i] / g;
+        __int128 t = static_cast<__int128>((ri - x) / g) * p % mg;
+        if (t < 0) t += mg;
+        x = static_cast<ll>(x + M * t);
+        M *= mg;
+        x %= M;
+    }
+    return std::make_pair(x, M);
+}
+
+/**
+ * @brief Garner のアルゴリズム - 互いに素な法についての連立合同式の解を、別
+ * の法 mod で求める。
+ * @return x ≡ r[i] (mod m[i]) を満たす最小の非負の x を mod で割った余り。
+ * @details 解を x = t0 + t1 m0 + t2 m0 m1 + ... の形で表し、係数 t を前から
+ * 順に決めていく。各 m の積が巨大で ll に収まらなくても使える。計算量は
+ * O(k^2 + k log m) 。積は mul_mod() で計算するので、法が 2^62 程度まで溢れ
+ * ない。
+ */
+inline ll garner(std::vector<ll> const &r, std::vector<ll> const &m,
+                 ll mod) {
+    assert(r.size() == m.size());
+    int k = r.size();
+
+    // coef[j] は m0 m1 ... m(i-1) (mod m[j]) 、 consts[j] は t0 + t1 m0 + ...
+    // + t(i-1) m0 ... m(i-2) (mod m[j]) 。 j = k は mod を表す。
+    std::vector<ll> coef(k + 1, 1), consts(k + 1, 0);
+    auto mod_of = [&](int j) { return j == k ? mod : m[j]; };
+    for (int i = 0; i < k; i++) {
+        ll ri = r[i] % m[i];
+        if (ri < 0) ri += m[i];
+        ll d = ri - consts[i];
+        if (d < 0) d += m[i];
+        ll t = mul_mod(d, inv_mod(coef[i], m[i]), m[i]);
+        for (int j = i + 1; j <= k; j++) {
+            ll mj     = mod_of(j);
+            consts[j] = (consts[j] + mul_mod(t % mj, coef[j], mj)) % mj;
+            coef[j]   = mul_mod(coef[j], m[i] % mj, mj);
+        }
+    }
+    return consts[k];
+}
+
 } // namespace pcl
@@ -1,6 +1,8 @@
 #include "prelude.hpp"
 
 #include "math/alg.hpp"
+#include "math/monoid.hpp"
+#include "wrapper/modint.hpp"
 
 #include <bits/stdc++.h>
 
@@ -24,4 +26,21 @@ int main() {
     cout << pow(a, b) << endl;
 
     cout << is_prime(a) << ' ' << is_prime(b) << endl;
+
+    ll ia = inv_mod(a, P7);
+    cout << ia << ' ' << (a * ia % P7) << endl;
+
+    int k;
+    cin >> k;
+    vector<ll> r(k), m(k);
+    cin >> r >> m;
+    auto xm = crt(r, m);
+    cout << xm.first << ' ' << xm.second << endl;
+    cout << garner(r, m, P7) << endl;
+
+    ull n;
+    cin >> n;
+    cout << pow<monoid::mul<mint>>(a, n) << endl;
+    auto f = pow<monoid::affine<mint>>(make_pair(mint(a), mint(b)), n);
+    cout << f.first << ' ' << f.second << endl;
 }
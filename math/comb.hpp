@@ -0,0 +1,133 @@
+/**
+ * @file math/comb.hpp
+ * @brief 階乗のテーブルによる二項係数の計算。
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include "../wrapper/modint.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace pcl {
+
+/**
+ * @brief 階乗とその逆元のテーブルを持ち、二項係数などを O(1) で求める。
+ * @details `MOD` は素数でなければならない。テーブルは必要になった分だけ (倍々
+ * に) 伸ばすので、最初に大きさを決めなくてもよい。伸ばすときは、階乗を前か
+ * ら計算したあと、末尾の階乗の逆元を一回だけ除算で求め、
+ * (n-1)!^{-1} = n!^{-1} * n を使って後ろから逆元を埋める。よって除算は伸ばす
+ * たびに一回で、残りは全て乗算になる。テーブルは MOD - 1 までしか作らない
+ * (MOD! ≡ 0 なので) 。 n >= MOD の二項係数は Lucas の定理で計算する。
+ */
+template <ll MOD>
+class combination {
+  public:
+    using value_type = modint<MOD>;
+
+  private:
+    /// fact_[i] = i!
+    std::vector<value_type> fact_;
+
+    /// inv_fact_[i] = (i!)^{-1}
+    std::vector<value_type> inv_fact_;
+
+  public:
+    /// n! まで (n < MOD) のテーブルを作る。
+    combination(ll n = 1)
+        : fact_(1, 1)
+        , inv_fact_(1, 1) {
+        reserve(n);
+    }
+
+    /**
+     * @brief n! まで計算されたテーブルを用意する。
+     * @details すでにあれば何もしない。足りなければ、少なくとも倍の長さまで
+     * 伸ばす。 n は MOD - 1 で打ち切られる。
+     */
+    void reserve(ll n) {
+        n = std::min(n, MOD - 1);
+        ll old = fact_.size();
+        if (n < old) return;
+        n = std::min(std::max(n + 1, old * 2), MOD) - 1;
+
+        fact_.resize(n + 1);
+        inv_fact_.resize(n + 1);
+        for (ll i = old; i <= n; i++) fact_[i] = fact_[i - 1] * i;
+        inv_fact_[n] = value_type(1) / fact_[n];
+        for (ll i = n; i > old; i--) inv_fact_[i - 1] = inv_fact_[i] * i;
+    }
+
+    /// n! (0 <= n)
+    value_type fact(ll n) {
+        assert(n >= 0);
+        if (n >= MOD) return 0;
+        reserve(n);
+        return fact_[n];
+    }
+
+    /// (n!)^{-1} (0 <= n < MOD)
+    value_type inv_fact(ll n) {
+        assert(in_range(0, n, MOD));
+        reserve(n);
+        return inv_fact_[n];
+    }
+
+    /// n の逆元 (1 <= n < MOD) 。 n^{-1} = (n-1)! * (n!)^{-1} 。
+    value_type inv(ll n) {
+        assert(in_range(1, n, MOD));
+        reserve(n);
+        return fact_[n - 1] * inv_fact_[n];
+    }
+
+    /**
+     * @brief 二項係数 nCr
+     * @details r < 0 または r > n なら 0 。 n < MOD なら O(1) (テーブルを伸
+     * ばす場合を除く) 、 n >= MOD なら Lucas の定理により O(log_MOD n) 。
+     */
+    value_type C(ll n, ll r) {
+        if (r < 0 || n < r) return 0;
+        if (n >= MOD) {
+            // Lucas の定理: MOD 進数の各桁ごとの二項係数の積になる。
+            value_type res = 1;
+            while (n > 0 || r > 0) {
+                ll ni = n % MOD, ri = r % MOD;
+                if (ni < ri) return 0;
+                res *= C(ni, ri);
+                n /= MOD, r /= MOD;
+            }
+            return res;
+        }
+        reserve(n);
+        return fact_[n] * inv_fact_[r] * inv_fact_[n - r];
+    }
+
+    /**
+     * @brief 順列の数 nPr
+     * @details r < 0 または r > n なら 0 。 n >= MOD のときは O(r) 。
+     */
+    value_type P(ll n, ll r) {
+        if (r < 0 || n < r) return 0;
+        if (n >= MOD) {
+            // n から連続する r 個の積。 r >= MOD なら 0 の倍数を含む。
+            if (r >= MOD) return 0;
+            value_type res = 1;
+            for (ll i = 0; i < r; i++) res *= n - i;
+            return res;
+        }
+        reserve(n);
+        return fact_[n] * inv_fact_[n - r];
+    }
+
+    /// 重複組合せの数 nHr = (n+r-1)Cr 。
+    value_type H(ll n, ll r) {
+        if (n == 0 && r == 0) return 1;
+        if (n <= 0 || r < 0) return 0;
+        return C(n + r - 1, r);
+    }
+};
+
+} // namespace pcl
@@ -0,0 +1,26 @@
+#include "prelude.hpp"
+
+#include "math/comb.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+int main() {
+    combination<P7> c7;
+    combination<13> c13;
+
+    int q;
+    cin >> q;
+    for (int i = 0; i < q; i++) {
+        char t;
+        ll n, r;
+        cin >> t >> n >> r;
+        if (t == 'C') cout << c7.C(n, r) << ' ' << c13.C(n, r) << endl;
+        if (t == 'P') cout << c7.P(n, r) << ' ' << c13.P(n, r) << endl;
+        if (t == 'H') cout << c7.H(n, r) << ' ' << c13.H(n, r) << endl;
+    }
+
+    cout << c7.inv(2) << ' ' << c7.fact(100000) << endl;
+}
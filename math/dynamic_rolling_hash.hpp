@@ -0,0 +1,111 @@
+/**
+ * @file math/dynamic_rolling_hash.hpp
+ * @brief 一点更新に対応した Rolling Hash 。
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include "../math/monoid.hpp"
+#include "../struct/segment_tree.hpp"
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+namespace pcl {
+
+/**
+ * @brief 一点更新に対応した Rolling Hash
+ * @details rolling_hash は累積和の形でハッシュ値を持つため、構築後に文字を書
+ * き換えることができない。ここでは monoid::hash を segment_tree に載せること
+ * で、文字の書き換えと区間のハッシュ値の取得をどちらも O(logN) で行う。
+ * 回文判定のために、元の文字列と反転した文字列の二本の segment_tree を同時に
+ * 保持している。剰余の法は rolling_hash と同じく 2^64 である。
+ */
+template <ull b>
+class dynamic_rolling_hash {
+  private:
+    using monoid_type = monoid::hash<b>;
+
+    /// 文字列の長さ
+    int size_;
+
+    /// 文字列そのもののハッシュ値を持つ segment_tree 。
+    segment_tree<monoid_type> fwd_;
+
+    /// 反転した文字列のハッシュ値を持つ segment_tree 。
+    segment_tree<monoid_type> rev_;
+
+    /// 文字列 s (を必要なら反転したもの) の各文字をモノイドの値にする。
+    static std::vector<typename monoid_type::value_type>
+    make_leaves(std::string const &s, bool reversed) {
+        int n = s.size();
+        std::vector<typename monoid_type::value_type> res(n);
+        for (int i = 0; i < n; i++) {
+            res[i] = monoid_type::of(s[reversed ? n - 1 - i : i]);
+        }
+        return res;
+    }
+
+  public:
+    /**
+     * @brief 与えられた文字列で初期化する。
+     * @param[in] s 文字列
+     * @details 計算量は O(N) 。
+     */
+    dynamic_rolling_hash(std::string const &s)
+        : size_(s.size())
+        , fwd_(make_leaves(s, false))
+        , rev_(make_leaves(s, true)) {
+    }
+
+    /// 文字列の長さ
+    int size() const {
+        return size_;
+    }
+
+    /**
+     * @brief i 文字目を c に書き換える。
+     * @details 計算量は O(logN) 。
+     */
+    void set(int i, char c) {
+        assert(in_range(0, i, size_));
+        fwd_.update(i, monoid_type::of(c));
+        rev_.update(size_ - 1 - i, monoid_type::of(c));
+    }
+
+    /**
+     * @brief 指定された範囲の文字列のハッシュ値を求める。
+     * @param[in] l 範囲の左端
+     * @param[in] r 範囲の右端 (右端は区間に含まない)
+     * @details 文字列が同じであれば rolling_hash<b>::of_range() と同じ値に
+     * なる。計算量は O(logN) 。
+     */
+    ull of_range(int l, int r) const {
+        assert(in_range_strict(0, {l, r}, size_ + 1));
+        return fwd_.find(l, r).hash;
+    }
+
+    /**
+     * @brief 指定された範囲の文字列を反転したもののハッシュ値を求める。
+     * @param[in] l 範囲の左端
+     * @param[in] r 範囲の右端 (右端は区間に含まない)
+     */
+    ull of_range_rev(int l, int r) const {
+        assert(in_range_strict(0, {l, r}, size_ + 1));
+        return rev_.find(size_ - r, size_ - l).hash;
+    }
+
+    /**
+     * @brief 指定された範囲の文字列が回文かどうかを判定する。
+     * @param[in] l 範囲の左端
+     * @param[in] r 範囲の右端 (右端は区間に含まない)
+     * @details ハッシュ値の比較による判定なので、衝突すれば誤判定しうる。
+     */
+    bool is_palindrome(int l, int r) const {
+        return of_range(l, r) == of_range_rev(l, r);
+    }
+};
+
+} // namespace pcl
@@ -0,0 +1,45 @@
+#include "prelude.hpp"
+
+#include "math/dynamic_rolling_hash.hpp"
+#include "math/rolling_hash.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+int main() {
+    int n, q;
+    cin >> n >> q;
+    string s;
+    cin >> s;
+    dynamic_rolling_hash<P7> drh(s);
+
+    for (int i = 0; i < q; i++) {
+        int com;
+        cin >> com;
+        if (com == 0) {
+            int x;
+            char c;
+            cin >> x >> c;
+            drh.set(x, c);
+            s[x] = c;
+        } else if (com == 1) {
+            int l1, r1, l2, r2;
+            cin >> l1 >> r1 >> l2 >> r2;
+            cout << (drh.of_range(l1, r1) == drh.of_range(l2, r2)) << endl;
+        } else {
+            int l, r;
+            cin >> l >> r;
+            cout << drh.is_palindrome(l, r) << endl;
+        }
+    }
+
+    // 更新後の文字列について、静的な rolling_hash と値が一致する。
+    rolling_hash<P7> rh(s);
+    bool same = true;
+    for (int l = 0; l <= n; l++)
+        for (int r = l; r <= n; r++)
+            same &= drh.of_range(l, r) == rh.of_range(l, r);
+    cout << same << endl;
+}
@@ -0,0 +1,85 @@
+#include "prelude.hpp"
+
+#include "math/fft.hpp"
+#include "math/ntt.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+int main() {
+    int n, m;
+    cin >> n >> m;
+    vector<ll> a(n), b(m);
+    for (auto &x : a) cin >> x;
+    for (auto &x : b) cin >> x;
+
+    auto c = convolution_fft_ll(a, b);
+    for (int i = 0; i < static_cast<int>(c.size()); i++) {
+        if (i != 0) cout << ' ';
+        cout << c[i];
+    }
+    cout << endl;
+
+    // 長い列でも正確な畳み込みと一致する。
+    int len;
+    cin >> len;
+    vector<ll> x(len), y(len + 3);
+    for (int i = 0; i < len; i++) x[i] = (i * 7919ll) % 100001 - 50000;
+    for (int i = 0; i < len + 3; i++) y[i] = (i * 104729ll) % 65537;
+    cout << (convolution_fft_ll(x, y) == convolution_ll(x, y)) << endl;
+
+    // 大きな値では FFT の精度が足りないので、正確な畳み込みに切り替える。
+    vector<ll> big_x(len, 1'000'000'000), big_y(len, -999'999'999);
+    cout << (convolution_fft_ll(big_x, big_y) ==
+             convolution_ll(big_x, big_y))
+         << endl;
+
+    // 長さや大きさが大きく違う列でも、誤差は長い方の列のエネルギーで決まる。
+    mt19937_64 rng(1);
+    vector<ll> two{1, -1}, one{1'000'000}, long_big(1 << 16),
+        long_small(1 << 16);
+    for (auto &v : long_big) v = static_cast<ll>(rng() % 200'000'001) - 1e8;
+    for (auto &v : long_small) v = static_cast<ll>(rng() % 2001) - 1000;
+    cout << (convolution_fft_ll(two, long_big) ==
+             convolution_ll(two, long_big))
+         << (convolution_fft_ll(long_big, one) ==
+             convolution_ll(long_big, one))
+         << (convolution_fft_ll(one, long_small) ==
+             convolution_ll(one, long_small))
+         << (convolution_fft_ll(long_big, long_small) ==
+             convolution_ll(long_big, long_small))
+         << endl;
+
+    // 順変換して逆変換すると元に戻る。
+    vector<double> re(len), im(len);
+    for (int i = 0; i < len; i++) re[i] = sin(i), im[i] = cos(3.0 * i);
+    auto re2 = re, im2 = im;
+    fft(re2, im2);
+    fft(re2, im2, true);
+    double err = 0;
+    for (int i = 0; i < len; i++) {
+        err = max(err, abs(re[i] - re2[i]));
+        err = max(err, abs(im[i] - im2[i]));
+    }
+    cout << (err < 1e-9) << endl;
+
+    cout << convolution_fft({}, {1.0}).size() << endl;
+
+    // 冪根のテーブルを伸ばす呼び出しが複数のスレッドで重なってもよい。
+    vector<int> ok(4);
+    vector<thread> ths;
+    for (int t = 0; t < 4; t++) {
+        ths.emplace_back([&, t] {
+            ok[t] = 1;
+            for (int k = 1; k <= 4 * len; k *= 2) {
+                vector<ll> u(k + t, 3), v(k, t + 1);
+                ok[t] &= convolution_fft_ll(u, v) == convolution_ll(u, v);
+            }
+        });
+    }
+    for (auto &th : ths) th.join();
+    for (int x : ok) cout << x;
+    cout << endl;
+}
@@ -0,0 +1,320 @@
+/**
+ * @file math/fps.hpp
+ * @brief 形式的冪級数 (Formal Power Series) 。
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include "../math/alg.hpp"
+#include "../math/ntt.hpp"
+#include "../wrapper/modint.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace pcl {
+
+/**
+ * @brief modint<MOD> 係数の形式的冪級数
+ * @details i 番目の要素が x^i の係数を表す std::vector<modint<MOD>> 。掛け算
+ * は NTT による畳み込みで行うので、 MOD は NTT-friendly な素数 (998244353 な
+ * ど) でなければならない。
+ * inv, log, exp, sqrt, pow は全て「x^n を法として」求める。いずれも Newton 法
+ * で精度を 1, 2, 4, ... と倍々にしていくので、計算量は O(n log n) 。 NTT 用
+ * のバッファは各段で使い回す。
+ */
+template <ll MOD>
+class fps : public std::vector<modint<MOD>> {
+  public:
+    using value_type = modint<MOD>;
+    using std::vector<value_type>::vector;
+
+    fps() = default;
+
+    fps(std::vector<value_type> const &v)
+        : std::vector<value_type>(v) {
+    }
+
+    fps(std::vector<value_type> &&v)
+        : std::vector<value_type>(std::move(v)) {
+    }
+
+    /// 先頭 n 項 (足りなければ 0 で埋める) 。 f mod x^n 。
+    fps prefix(int n) const {
+        fps res(n);
+        std::copy(this->begin(),
+                  this->begin() + std::min<int>(n, this->size()),
+                  res.begin());
+        return res;
+    }
+
+    fps &operator+=(fps const &o) {
+        if (this->size() < o.size()) this->resize(o.size());
+        for (int i = 0; i < static_cast<int>(o.size()); i++) {
+            (*this)[i] += o[i];
+        }
+        return *this;
+    }
+
+    fps &operator-=(fps const &o) {
+        if (this->size() < o.size()) this->resize(o.size());
+        for (int i = 0; i < static_cast<int>(o.size()); i++) {
+            (*this)[i] -= o[i];
+        }
+        return *this;
+    }
+
+    fps &operator*=(fps const &o) {
+        return *this = fps(convolution<MOD>(*this, o));
+    }
+
+    fps &operator*=(value_type const &c) {
+        for (auto &x : *this) x *= c;
+        return *this;
+    }
+
+    /// 微分
+    fps derivative() const {
+        int n = this->size();
+        if (n <= 1) return fps();
+        fps res(n - 1);
+        for (int i = 1; i < n; i++) res[i - 1] = (*this)[i] * i;
+        return res;
+    }
+
+    /**
+     * @brief 積分 (定数項は 0)
+     * @details 1, ..., n の逆元は inv[i] = -(MOD / i) * inv[MOD % i] により
+     * まとめて O(n) で求める。
+     */
+    fps integral() const {
+        int n = this->size();
+        fps res(n + 1);
+        auto inv = inverses_impl(n);
+        for (int i = 0; i < n; i++) res[i + 1] = (*this)[i] * inv[i + 1];
+        return res;
+    }
+
+    /**
+     * @brief Newton 法の一段で、 h = 1/f mod x^m を 1/f mod x^{2m} に伸ばす。
+     * @param[in] f 先頭 2m 項だけ使う (足りなければ 0 とみなす) 。
+     * @param[in] H h を長さ 2m で NTT したもの
+     * @param[inout] buf 作業領域
+     * @details h <- h (2 - f h) 。 f h ≡ 1 (mod x^m) なので f h の下位 m 項
+     * は既知であり、長さ 2m の巡回畳み込みで上位 m 項だけ求めればよい。
+     */
+    static void inv_step_impl(std::vector<value_type> const &f, fps &h,
+                              std::vector<value_type> const &H,
+                              std::vector<value_type> &buf, int m) {
+        buf.assign(2 * m, 0);
+        std::copy(f.begin(), f.begin() + std::min<int>(2 * m, f.size()),
+                  buf.begin());
+        ntt(buf);
+        for (int i = 0; i < 2 * m; i++) buf[i] *= H[i];
+        ntt(buf, true);
+
+        // 下位 m 項 (1, 0, ..., 0) を落として、上位だけを h と掛ける。
+        std::fill(buf.begin(), buf.begin() + m, 0);
+        ntt(buf);
+        for (int i = 0; i < 2 * m; i++) buf[i] *= H[i];
+        ntt(buf, true);
+
+        h.resize(2 * m);
+        for (int i = m; i < 2 * m; i++) h[i] = -buf[i];
+    }
+
+    /// h を長さ 2m に 0 で伸ばして NTT したものを H に入れる。
+    static void transform_impl(fps const &h, std::vector<value_type> &H,
+                               int m) {
+        H.assign(2 * m, 0);
+        std::copy(h.begin(), h.begin() + std::min<int>(2 * m, h.size()),
+                  H.begin());
+        ntt(H);
+    }
+
+    /// 1, ..., n の逆元
+    static std::vector<value_type> inverses_impl(int n) {
+        std::vector<value_type> inv(n + 1, 1);
+        for (int i = 2; i <= n; i++) inv[i] = -(MOD / i) * inv[MOD % i];
+        return inv;
+    }
+
+    /**
+     * @brief 逆元 1/f mod x^n
+     * @details f[0] != 0 でなければならない。 inv_step_impl() で精度を倍々に
+     * する。 NTT 用のバッファは最初に最終的な長さで確保し、各段で使い回す。
+     */
+    fps inv(int n) const {
+        assert(!this->empty() && (*this)[0] != 0);
+        fps g(1, value_type(1) / (*this)[0]);
+        std::vector<value_type> G, buf;
+        G.reserve(2 * n), buf.reserve(2 * n);
+        for (int m = 1; m < n; m *= 2) {
+            transform_impl(g, G, m);
+            inv_step_impl(*this, g, G, buf, m);
+        }
+        g.resize(n);
+        return g;
+    }
+
+    /**
+     * @brief 対数 log f mod x^n
+     * @details f[0] = 1 でなければならない。 log f = ∫ f' / f 。
+     */
+    fps log(int n) const {
+        assert(!this->empty() && (*this)[0] == 1);
+        if (n <= 0) return fps();
+        fps d = prefix(n).derivative();
+        d *= inv(n);
+        return d.prefix(n - 1).integral();
+    }
+
+    /**
+     * @brief 指数関数 exp f mod x^n
+     * @details f[0] = 0 でなければならない。 g = exp f mod x^m と
+     * h = 1/g mod x^m を同時に倍々にする。 g <- g (1 + f - log g) の
+     * f - log g は下位 m 項が 0 で、 f_{<m} - log g = ∫ (f_{<m}' g - g') h
+     * (x^{2m-1} を法として) なので、 log g を一から計算し直さずに済む。 h は
+     * inv_step_impl() で伸ばす。 NTT 用のバッファは各段で使い回す。
+     */
+    fps exp(int n) const {
+        assert(this->empty() || (*this)[0] == 0);
+        if (n <= 0) return fps();
+        int const sz = this->size();
+        auto coef    = [&](int i) { return i < sz ? (*this)[i] : 0; };
+        auto inv     = inverses_impl(2 * n);
+
+        fps g(1, 1), h(1, 1);
+        std::vector<value_type> G, H, buf;
+        G.reserve(2 * n), H.reserve(2 * n), buf.reserve(2 * n);
+        for (int m = 1; m < n; m *= 2) {
+            transform_impl(g, G, m);
+            transform_impl(h, H, m);
+
+            // f_{<m}' g - g' 。次数は 2m - 2 以下で、下位 m - 1 項は 0 。
+            buf.assign(2 * m, 0);
+            for (int i = 1; i < m; i++) buf[i - 1] = coef(i) * i;
+            ntt(buf);
+            for (int i = 0; i < 2 * m; i++) buf[i] *= G[i];
+            ntt(buf, true);
+            for (int i = 1; i < m; i++) buf[i - 1] -= g[i] * i;
+
+            // h を掛けて積分し、 f の上位 m 項を足すと f - log g になる。
+            ntt(buf);
+            for (int i = 0; i < 2 * m; i++) buf[i] *= H[i];
+            ntt(buf, true);
+            for (int i = 2 * m - 2; i >= m - 1; i--) {
+                buf[i + 1] = buf[i] * inv[i + 1];
+            }
+            for (int i = m; i < 2 * m; i++) buf[i] += coef(i);
+            std::fill(buf.begin(), buf.begin() + m, 0);
+
+            ntt(buf);
+            for (int i = 0; i < 2 * m; i++) buf[i] *= G[i];
+            ntt(buf, true);
+            g.resize(2 * m);
+            std::copy(buf.begin() + m, buf.end(), g.begin() + m);
+
+            if (2 * m < n) inv_step_impl(g, h, H, buf, m);
+        }
+        g.resize(n);
+        return g;
+    }
+
+    /**
+     * @brief 平方根 √f mod x^n
+     * @return g^2 ≡ f (mod x^n) を満たす g の一つ。存在しなければ空。
+     * @details 最下位の非零項が x^d c のとき、 d が偶数かつ c が平方剰余でな
+     * ければ存在しない。 f / x^d について g <- g + (f - g^2) / 2g で精度を倍
+     * にし、最後に x^(d/2) を掛ける。 exp() と同じく h = 1/g mod x^m も同時
+     * に倍々にするので、逆元を一から計算し直さずに済む。
+     */
+    fps sqrt(int n) const {
+        int d = 0;
+        while (d < static_cast<int>(this->size()) && (*this)[d] == 0) d++;
+        if (d >= std::min<int>(n, this->size())) return fps(n);
+        if (d % 2 != 0) return fps();
+        ll s = sqrt_mod(static_cast<ll>((*this)[d]), MOD);
+        if (s == -1) return fps();
+
+        int len = n - d / 2;
+        fps f(this->begin() + d, this->end());
+        int const sz = f.size();
+        fps g(1, s), h(1, value_type(1) / s);
+        value_type const inv2 = value_type(1) / 2;
+        std::vector<value_type> H, buf;
+        H.reserve(2 * len), buf.reserve(2 * len);
+        for (int m = 1; m < len; m *= 2) {
+            // f - g^2 。 g^2 の次数は 2m - 2 以下で、下位 m 項は f と一致。
+            transform_impl(g, buf, m);
+            for (int i = 0; i < 2 * m; i++) buf[i] *= buf[i];
+            ntt(buf, true);
+            for (int i = 0; i < m; i++) buf[i] = 0;
+            for (int i = m; i < 2 * m; i++) {
+                buf[i] = (i < sz ? f[i] : 0) - buf[i];
+            }
+
+            transform_impl(h, H, m);
+            ntt(buf);
+            for (int i = 0; i < 2 * m; i++) buf[i] *= H[i];
+            ntt(buf, true);
+            g.resize(2 * m);
+            for (int i = m; i < 2 * m; i++) g[i] = buf[i] * inv2;
+
+            if (2 * m < len) inv_step_impl(g, h, H, buf, m);
+        }
+        g.resize(len);
+        g.insert(g.begin(), d / 2, 0);
+        return g;
+    }
+
+    /**
+     * @brief 冪乗 f^k mod x^n
+     * @details 最下位の非零項 x^d c をくくり出して f = c x^d g (g[0] = 1) と
+     * し、 g^k = exp(k log g) を使う。 k は 64 bit でよい。
+     */
+    fps pow(ull k, int n) const {
+        int d = 0;
+        while (d < static_cast<int>(this->size()) && (*this)[d] == 0) d++;
+        if (k == 0) {
+            fps res(n);
+            if (n > 0) res[0] = 1;
+            return res;
+        }
+        // d * k >= n なら全て 0 (オーバーフローしないよう割り算で判定) 。
+        if (d == static_cast<int>(this->size()) ||
+            (d > 0 && k >= static_cast<ull>((n + d - 1) / d))) {
+            return fps(n);
+        }
+
+        int shift    = d * k;
+        value_type c = (*this)[d];
+        fps g(this->begin() + d, this->end());
+        g *= value_type(1) / c;
+        fps res = g.log(n - shift);
+        res *= value_type(k % MOD);
+        res = res.exp(n - shift);
+        res *= value_type(pow_mod(static_cast<ll>(c), k, MOD));
+        res.insert(res.begin(), shift, 0);
+        return res;
+    }
+};
+
+template <ll MOD>
+fps<MOD> operator+(fps<MOD> a, fps<MOD> const &b) {
+    return a += b;
+}
+
+template <ll MOD>
+fps<MOD> operator-(fps<MOD> a, fps<MOD> const &b) {
+    return a -= b;
+}
+
+template <ll MOD>
+fps<MOD> operator*(fps<MOD> a, fps<MOD> const &b) {
+    return a *= b;
+}
+
+} // namespace pcl
@@ -0,0 +1,107 @@
+#include "prelude.hpp"
+
+#include "math/fps.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+using mint998 = modint<998244353>;
+using poly    = fps<998244353>;
+
+// 以下は O(n^2) の愚直な実装。
+
+poly naive_mul(poly const &a, poly const &b, int n) {
+    poly res(n);
+    for (int i = 0; i < static_cast<int>(a.size()); i++)
+        for (int j = 0; j < static_cast<int>(b.size()) && i + j < n; j++)
+            res[i + j] += a[i] * b[j];
+    return res;
+}
+
+poly naive_inv(poly const &f, int n) {
+    poly g(n);
+    mint998 i0 = mint998(1) / f[0];
+    for (int i = 0; i < n; i++) {
+        mint998 s = i == 0 ? mint998(1) : mint998(0);
+        for (int j = 1; j <= i && j < static_cast<int>(f.size()); j++)
+            s -= f[j] * g[i - j];
+        g[i] = s * i0;
+    }
+    return g;
+}
+
+// f' = f g' より i g_i = i f_i - Σ_{j<i} j g_j f_{i-j}
+poly naive_log(poly const &f, int n) {
+    poly g(n);
+    for (int i = 1; i < n; i++) {
+        mint998 s = f[i] * i;
+        for (int j = 1; j < i; j++) s -= g[j] * j * f[i - j];
+        g[i] = s / i;
+    }
+    return g;
+}
+
+// g' = g f' より i g_i = Σ_{j<=i} j f_j g_{i-j}
+poly naive_exp(poly const &f, int n) {
+    poly g(n);
+    g[0] = 1;
+    for (int i = 1; i < n; i++) {
+        mint998 s = 0;
+        for (int j = 1; j <= i; j++) s += f[j] * j * g[i - j];
+        g[i] = s / i;
+    }
+    return g;
+}
+
+poly naive_pow(poly f, ull k, int n) {
+    poly res(n);
+    res[0] = 1;
+    while (k > 0) {
+        if (k & 1) res = naive_mul(res, f, n);
+        f = naive_mul(f, f, n);
+        k >>= 1;
+    }
+    return res;
+}
+
+int main() {
+    int n;
+    ull k, seed;
+    cin >> n >> k >> seed;
+
+    poly f(n);
+    for (auto &x : f) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        x    = static_cast<ll>(seed >> 34);
+    }
+
+    poly f1 = f, f0 = f;
+    f1[0] = 1, f0[0] = 0;
+
+    cout << (f.inv(n) == naive_inv(f, n)) << endl;
+    cout << (f1.log(n) == naive_log(f1, n)) << endl;
+    cout << (f0.exp(n) == naive_exp(f0, n)) << endl;
+    cout << (f.pow(k, n) == naive_pow(f, k, n)) << endl;
+
+    // 下位の係数が 0 の場合
+    poly g = f;
+    g[0] = g[1] = 0;
+    cout << (g.pow(k, n) == naive_pow(g, k, n)) << endl;
+
+    // 平方根は二乗して元に戻ることを確かめる。
+    poly sq = naive_mul(g, g, n);
+    poly r  = sq.sqrt(n);
+    cout << (naive_mul(r, r, n) == sq) << endl;
+
+    // 平方根が存在しない場合 (最下位の次数が奇数)
+    poly odd(n);
+    odd[1] = 1;
+    cout << odd.sqrt(n).empty() << endl;
+
+    // 小さい例: 1 / (1 - x - x^2) はフィボナッチ数列
+    poly fib = poly{1, -1, -1}.inv(10);
+    for (auto const &x : fib) cout << x << ' ';
+    cout << endl;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file math/linear_recurrence.hpp
+ * @brief 線形漸化式の推定と第 N 項の計算。
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include "../math/ntt.hpp"
+#include "../wrapper/modint.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace pcl {
+
+/**
+ * @brief Berlekamp-Massey 法で、列を生成する最短の線形漸化式を求める。
+ * @return c (長さ d) 。 i >= d について s[i] = Σ_{j=1}^{d} c[j-1] s[i-j] が成
+ * り立つ、 d が最小のもの。
+ * @details T は体 (素数を法とする modint など) でなければならない。次数 d の
+ * 漸化式を求めるには長さ 2d 程度の列が必要。計算量は O(|s|^2) 。
+ */
+template <typename T>
+std::vector<T> berlekamp_massey(std::vector<T> const &s) {
+    int n = s.size();
+    // c は s[i] + Σ_{j=1}^{len} c[j] s[i-j] = 0 を満たす多項式 (c[0] = 1) 、
+    // b は最後に len が変わる直前の c 。
+    std::vector<T> c{1}, b{1};
+    int len = 0, shift = 1;
+    T last = 1;
+    for (int i = 0; i < n; i++) {
+        // s[i] と漸化式による予測とのずれ
+        T d = s[i];
+        for (int j = 1; j <= len; j++) d += c[j] * s[i - j];
+        if (d == T(0)) {
+            shift++;
+            continue;
+        }
+
+        T coef = d / last;
+        if (c.size() < b.size() + shift) c.resize(b.size() + shift);
+        if (2 * len <= i) {
+            std::vector<T> old = c;
+            for (int j = 0; j < static_cast<int>(b.size()); j++) {
+                c[j + shift] -= coef * b[j];
+            }
+            len   = i + 1 - len;
+            b     = old;
+            last  = d;
+            shift = 1;
+        } else {
+            for (int j = 0; j < static_cast<int>(b.size()); j++) {
+                c[j + shift] -= coef * b[j];
+            }
+            shift++;
+        }
+    }
+
+    c.resize(std::max<int>(c.size(), len + 1));
+    std::vector<T> res(len);
+    for (int j = 0; j < len; j++) res[j] = T(0) - c[j + 1];
+    return res;
+}
+
+/**
+ * @brief Kitamasa 法で、線形漸化式で定まる列の第 n 項を求める。
+ * @param[in] c 漸化式 a[i] = Σ_{j=1}^{k} c[j-1] a[i-j] の係数
+ * @param[in] a 初項 a[0], ..., a[k-1]
+ * @details x^n を特性多項式 x^k - c[0] x^{k-1} - ... - c[k-1] で割った余り
+ * r(x) を繰り返し二乗法で求めると、 a[n] = Σ r_i a[i] になる。多項式の積と
+ * 剰余は愚直に行うので、計算量は O(k^2 log n) 。 k x k 行列の冪 (O(k^3 log
+ * n)) の代わりに使える。 T は環であればよく、法が素数でなくてもよい。
+ */
+template <typename T>
+T kitamasa(std::vector<T> const &c, std::vector<T> const &a, ull n) {
+    int k = c.size();
+    assert(static_cast<int>(a.size()) >= k);
+    if (n < a.size()) return a[n];
+    if (k == 0) return T(0);
+
+    // p * q mod 特性多項式
+    auto mul_mod = [&](std::vector<T> const &p, std::vector<T> const &q) {
+        std::vector<T> prod(2 * k - 1);
+        for (int i = 0; i < k; i++)
+            for (int j = 0; j < k; j++) prod[i + j] += p[i] * q[j];
+        // x^i = Σ c[j-1] x^{i-j} で上の次数から消していく。
+        for (int i = 2 * k - 2; i >= k; i--) {
+            for (int j = 1; j <= k; j++) prod[i - j] += prod[i] * c[j - 1];
+        }
+        prod.resize(k);
+        return prod;
+    };
+
+    // r = x^0 から、 n の上のビットから順に二乗して x を掛ける。
+    std::vector<T> r(k);
+    r[0]   = 1;
+    int hi = 63;
+    while (!(n >> hi & 1)) hi--;
+    for (int b = hi; b >= 0; b--) {
+        r = mul_mod(r, r);
+        if (n >> b & 1) {
+            // x を掛ける: 次数を一つ上げ、 x^k を消す。
+            T top = r[k - 1];
+            for (int i = k - 1; i > 0; i--) {
+                r[i] = r[i - 1] + top * c[k - 1 - i];
+            }
+            r[0] = top * c[k - 1];
+        }
+    }
+
+    T res = 0;
+    for (int i = 0; i < k; i++) res += r[i] * a[i];
+    return res;
+}
+
+/**
+ * @brief 結果の長さの NTT が MOD で使えるなら convolution() 、そうでなければ
+ * convolution_arbitrary() で畳み込む。
+ */
+template <ll MOD>
+std::vector<modint<MOD>>
+recurrence_convolution_impl(std::vector<modint<MOD>> const &a,
+                            std::vector<modint<MOD>> const &b) {
+    ll z = 1;
+    while (z < static_cast<ll>(a.size() + b.size()) - 1) z *= 2;
+    if ((MOD - 1) % z == 0) return convolution(a, b);
+    return convolution_arbitrary(a, b);
+}
+
+/**
+ * @brief Bostan-Mori 法で、有理式 p(x) / q(x) の x^n の係数を求める。
+ * @details q[0] は 0 であってはならず、 |p| < |q| でなければならない。
+ * p/q = p(x) q(-x) / (q(x) q(-x)) で分母は x^2 の多項式になるので、分子の
+ * n と偶奇が同じ次数の項だけ残せば n を半分にできる。 MOD が NTT-friendly な
+ * 素数なら NTT で、そうでなければ三つの素数の NTT で畳み込むので、計算量は
+ * O(k log k log n) (k = |q|) 。
+ */
+template <ll MOD>
+modint<MOD> bostan_mori(std::vector<modint<MOD>> p,
+                        std::vector<modint<MOD>> q, ull n) {
+    assert(!q.empty() && q[0] != 0);
+    assert(p.size() < q.size());
+    if (p.empty()) return 0;
+
+    while (n > 0) {
+        std::vector<modint<MOD>> qm = q;
+        for (int i = 1; i < static_cast<int>(qm.size()); i += 2) {
+            qm[i] = -qm[i];
+        }
+        auto u = recurrence_convolution_impl(p, qm);
+        auto v = recurrence_convolution_impl(q, qm);
+
+        p.assign((u.size() + 1 - n % 2) / 2, 0);
+        for (int i = 0; i < static_cast<int>(p.size()); i++) {
+            p[i] = u[2 * i + n % 2];
+        }
+        q.assign((v.size() + 1) / 2, 0);
+        for (int i = 0; i < static_cast<int>(q.size()); i++) q[i] = v[2 * i];
+        if (p.empty()) return 0;
+        n /= 2;
+    }
+    return p[0] / q[0];
+}
+
+/**
+ * @brief 線形漸化式で定まる列の第 n 項を Bostan-Mori 法で求める。
+ * @param[in] c 漸化式 a[i] = Σ_{j=1}^{k} c[j-1] a[i-j] の係数
+ * @param[in] a 初項 a[0], ..., a[k-1]
+ * @details 母関数は p(x) / q(x) 、 q(x) = 1 - c[0] x - ... - c[k-1] x^k 、
+ * p(x) = (a(x) q(x) mod x^k) となる。 k が大きいときは kitamasa() より速い。
+ */
+template <ll MOD>
+modint<MOD> linear_recurrence_nth(std::vector<modint<MOD>> const &c,
+                                  std::vector<modint<MOD>> const &a, ull n) {
+    int k = c.size();
+    assert(static_cast<int>(a.size()) >= k);
+    if (n < a.size()) return a[n];
+
+    std::vector<modint<MOD>> q(k + 1);
+    q[0] = 1;
+    for (int j = 0; j < k; j++) q[j + 1] = -c[j];
+    std::vector<modint<MOD>> init(a.begin(), a.begin() + k);
+    auto p = recurrence_convolution_impl(init, q);
+    p.resize(k);
+    return bostan_mori(p, q, n);
+}
+
+} // namespace pcl
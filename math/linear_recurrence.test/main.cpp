@@ -0,0 +1,80 @@
+#include "prelude.hpp"
+
+#include "math/linear_recurrence.hpp"
+#include "struct/mat.hpp"
+#include "wrapper/modint.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+using mint998 = modint<998244353>;
+
+/// 次数 k のランダムな漸化式で、推定と第 n 項が定義通りの計算と一致するか。
+template <ll MOD>
+bool check_random(int k) {
+    using T = modint<MOD>;
+    mt19937_64 rng(k);
+    vector<T> c(k), a(k);
+    for (auto &x : c) x = rng() % MOD;
+    for (auto &x : a) x = rng() % MOD;
+
+    int len = 2 * k + 300;
+    vector<T> s = a;
+    for (int i = k; i < len; i++) {
+        T x = 0;
+        for (int j = 1; j <= k; j++) x += c[j - 1] * s[i - j];
+        s.push_back(x);
+    }
+    if (berlekamp_massey(vector<T>(s.begin(), s.begin() + 2 * k)) != c) {
+        return false;
+    }
+    for (int n : {0, k - 1, k, len - 1}) {
+        if (kitamasa(c, a, n) != s[n]) return false;
+        if (linear_recurrence_nth(c, a, n) != s[n]) return false;
+    }
+
+    // 大きい n では、 k x k 行列の冪と比べる。
+    ull n = 1'000'000'000'000'000'000ull + k;
+    T x   = kitamasa(c, a, n);
+    if (linear_recurrence_nth(c, a, n) != x) return false;
+    if (k <= 20) {
+        mat<T> m(k, k);
+        for (int j = 0; j < k; j++) m.at(0, j) = c[j];
+        for (int i = 1; i < k; i++) m.at(i, i - 1) = 1;
+        // (a[n], ..., a[n-k+1]) = m^(n-k+1) (a[k-1], ..., a[0])
+        mat<T> p = pow(m, n - k + 1);
+        T y      = 0;
+        for (int j = 0; j < k; j++) y += p.at(0, j) * a[k - 1 - j];
+        if (x != y) return false;
+    }
+    return true;
+}
+
+int main() {
+    int len;
+    cin >> len;
+    vector<mint998> s(len);
+    cin >> s;
+    auto c = berlekamp_massey(s);
+    cout << c.size() << endl;
+    for (int i = 0; i < static_cast<int>(c.size()); i++) {
+        cout << c[i] << " \n"[i == static_cast<int>(c.size()) - 1];
+    }
+
+    int q;
+    cin >> q;
+    vector<mint998> a(s.begin(), s.begin() + c.size());
+    for (int i = 0; i < q; i++) {
+        ull n;
+        cin >> n;
+        cout << kitamasa(c, a, n) << ' ' << linear_recurrence_nth(c, a, n)
+             << endl;
+    }
+
+    cout << check_random<998244353>(5) << endl;
+    cout << check_random<998244353>(150) << endl;
+    cout << check_random<P7>(7) << endl;
+    cout << check_random<P7>(100) << endl;
+}
@@ -15,6 +15,9 @@
 
 #include "../prelude.hpp"
 
+#include <algorithm>
+#include <utility>
+
 namespace pcl { namespace monoid {
 
     /**
@@ -37,4 +40,86 @@ namespace pcl { namespace monoid {
         }
     };
 
+    /**
+     * @brief 乗算のモノイド。
+     * @details T は次の条件を満たしていればよい:
+     * - operator*() が定義されている。
+     * - T(1) が * の単位元になる。
+     */
+    template <typename T>
+    struct mul {
+        using value_type = T;
+
+        constexpr static value_type id() {
+            return T(1);
+        }
+
+        constexpr static value_type op(value_type const &a,
+                                       value_type const &b) {
+            return a * b;
+        }
+    };
+
+    /**
+     * @brief アフィン変換 x -> ax + b の合成のモノイド。
+     * @details 値 (a, b) は x -> ax + b を表す。 op(f, g) は「f を適用して
+     * から g を適用する」変換 g(f(x)) になる。したがって列を左から畳み込む
+     * と、左から順に適用した変換が得られる。
+     */
+    template <typename T>
+    struct affine {
+        using value_type = std::pair<T, T>;
+
+        constexpr static value_type id() {
+            return value_type(T(1), T(0));
+        }
+
+        constexpr static value_type op(value_type const &f,
+                                       value_type const &g) {
+            return value_type(g.first * f.first,
+                              g.first * f.second + g.second);
+        }
+
+        /// 変換 f を x に適用する。
+        constexpr static T apply(value_type const &f, T const &x) {
+            return f.first * x + f.second;
+        }
+    };
+
+    /**
+     * @brief 区間のハッシュ値を合成するモノイド。
+     * @details 基数 base の Rolling Hash の値と、その区間の長さ (および base^長さ)
+     * をまとめて持つ。二つの区間 s, t のハッシュ値から連結 st のハッシュ値
+     * を O(1) で求められるので、 segment_tree に載せれば一点更新に対応した
+     * Rolling Hash が作れる。剰余の法は rolling_hash と同じく 2^64 とする。
+     */
+    template <ull base>
+    struct hash {
+        struct value_type {
+            /// 区間のハッシュ値
+            ull hash;
+
+            /// base^len 。連結時に左側のハッシュ値をずらすのに使う。
+            ull pow;
+
+            /// 区間の長さ
+            ll len;
+        };
+
+        constexpr static value_type id() {
+            return value_type{0, 1, 0};
+        }
+
+        /// 一文字 c からなる区間の値を作る。
+        constexpr static value_type of(ull c) {
+            return value_type{c, base, 1};
+        }
+
+        constexpr static value_type op(value_type const &a,
+                                       value_type const &b) {
+            return value_type{a.hash * b.pow + b.hash, a.pow * b.pow,
+                              a.len + b.len};
+        }
+    };
+
 }} // namespace pcl::monoid
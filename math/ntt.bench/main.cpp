@@ -0,0 +1,59 @@
+/// ベンチマーク: NTT による畳み込みと愚直な畳み込み
+/// 使い方: ./a.out [愚直な畳み込みを測る最大の長さ (既定 2^15)]
+/// > bench_output.txt
+
+#include "prelude.hpp"
+
+#include "math/ntt.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+using mint998 = modint<998244353>;
+
+/// f() を reps 回実行した中で最短の時間 (秒)
+template <typename F>
+double seconds(F const &f, int reps = 3) {
+    double best = 1e18;
+    for (int r = 0; r < reps; r++) {
+        auto start = chrono::steady_clock::now();
+        f();
+        chrono::duration<double> d = chrono::steady_clock::now() - start;
+        best = min(best, d.count());
+    }
+    return best;
+}
+
+int main(int argc, char **argv) {
+    int naive_max = argc > 1 ? atoi(argv[1]) : 1 << 15;
+    mt19937_64 rng(1);
+
+    // 長さ n 同士の畳み込み
+    for (int n = 1 << 10; n <= 1 << 22; n *= 2) {
+        vector<mint998> a(n), b(n);
+        for (auto &x : a) x = rng() % 998244353;
+        for (auto &x : b) x = rng() % 998244353;
+
+        vector<mint998> c;
+        double ntt_s = seconds([&] { c = convolution(a, b); });
+        if (n <= naive_max) {
+            double naive_s = seconds([&] { c = convolution_naive(a, b); });
+            printf("n=%8d naive %9.5fs ntt %9.5fs (x%.1f)\n", n, naive_s,
+                   ntt_s, naive_s / ntt_s);
+        } else {
+            printf("n=%8d naive         - ntt %9.5fs\n", n, ntt_s);
+        }
+    }
+
+    // 任意の法 (三つの素数) と整数列の畳み込み
+    for (int n = 1 << 10; n <= 1 << 22; n *= 2) {
+        vector<mint> a(n), b(n);
+        for (auto &x : a) x = rng() % P7;
+        for (auto &x : b) x = rng() % P7;
+        vector<mint> c;
+        double s = seconds([&] { c = convolution_arbitrary(a, b); });
+        printf("n=%8d convolution_arbitrary (mod 1e9+7) %9.5fs\n", n, s);
+    }
+}
@@ -0,0 +1,274 @@
+/**
+ * @file math/ntt.hpp
+ * @brief 数論変換 (NTT) による畳み込み。
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include "../math/alg.hpp"
+#include "../wrapper/modint.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace pcl {
+
+/// mod を法とする NTT の最大の長さ (mod - 1 を割り切る最大の 2 の冪)
+constexpr ll ntt_max_len(ll mod) {
+    return (mod - 1) & -(mod - 1);
+}
+
+/**
+ * @brief 長さ n の NTT に使う 1 の冪根のテーブルを返す。
+ * @return テーブル rt 。 len が 2 の冪のとき、 rt[len + j] は 1 の原始 2len
+ * 乗根 w の j 乗 (0 <= j < len) 。同じスレッドで次に ntt_roots<MOD>() を呼
+ * ぶまで有効。
+ * @details MOD は奇素数で、 n は ntt_max_len(MOD) 以下でなければならない。
+ * 998244353 のような、 MOD - 1 が大きな 2 の冪で割り切れる素数 (NTT-friendly
+ * な素数) なら長い NTT に使える。テーブルは MOD ごとに一つだけ持ち、必要に
+ * なった長さまで伸ばしていく。伸ばすときは mutex の中で新しいテーブルを作っ
+ * て差し替え、一度作ったテーブルは書き換えないので、複数のスレッドから同時に
+ * 呼んでよい。各スレッドは最後に見たテーブルを持っておき、それで足りれば
+ * mutex をとらずに返す。
+ */
+template <ll MOD>
+std::vector<modint<MOD>> const &ntt_roots(int n) {
+    static_assert(MOD > 2 && MOD % 2 == 1, "MOD must be an odd prime");
+    using table = std::vector<modint<MOD>>;
+    static thread_local std::shared_ptr<table const> local;
+    if (local && static_cast<int>(local->size()) >= n) return *local;
+
+    static std::mutex mtx;
+    static std::shared_ptr<table const> shared =
+        std::make_shared<table const>(2, 1);
+    static ll const g = primitive_root(MOD);
+
+    std::lock_guard<std::mutex> lk(mtx);
+    if (static_cast<int>(shared->size()) < n) {
+        // 1 の原始 n 乗根がなければならない。
+        assert(n <= ntt_max_len(MOD));
+        auto next = std::make_shared<table>(*shared);
+        for (int len = next->size() / 2; len < n / 2; len *= 2) {
+            // 1 の原始 4len 乗根
+            modint<MOD> w = pow_mod(g, (MOD - 1) / (4 * len), MOD);
+            next->resize(4 * len);
+            for (int j = 0; j < len; j++) {
+                (*next)[2 * len + 2 * j]     = (*next)[len + j];
+                (*next)[2 * len + 2 * j + 1] = (*next)[len + j] * w;
+            }
+        }
+        shared = next;
+    }
+    local = shared;
+    return *local;
+}
+
+/**
+ * @brief 数論変換 (in-place)
+ * @param[inout] a 変換する列。長さは ntt_max_len(MOD) 以下の 2 の冪でなけれ
+ * ばならない。
+ * @param[in] inverse true なら逆変換 (1/n 倍まで含む) を行う。
+ * @details ビット反転で並べ替えてから、長さ 2, 4, 8, ... のバタフライを下か
+ * ら順に行う反復版の Cooley-Tukey 。回転因子は ntt_roots() の事前計算したも
+ * のを使うので、ループ中に冪乗の計算はしない。逆変換は、 a[1..n] を反転して
+ * から順変換すれば w の代わりに w^{-1} を使ったのと同じになることを使う。計
+ * 算量は O(n log n) 。
+ */
+template <ll MOD>
+void ntt(std::vector<modint<MOD>> &a, bool inverse = false) {
+    int n = a.size();
+    assert((n & (n - 1)) == 0);
+    if (n <= 1) return;
+
+    auto const &rt = ntt_roots<MOD>(n);
+
+    if (inverse) std::reverse(a.begin() + 1, a.end());
+    for (int i = 1, j = 0; i < n; i++) {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(a[i], a[j]);
+    }
+
+    for (int len = 1; len < n; len <<= 1) {
+        for (int i = 0; i < n; i += 2 * len) {
+            for (int j = 0; j < len; j++) {
+                modint<MOD> u = a[i + j], v = a[i + j + len] * rt[len + j];
+                a[i + j]       = u + v;
+                a[i + j + len] = u - v;
+            }
+        }
+    }
+
+    if (inverse) {
+        modint<MOD> inv_n = modint<MOD>(1) / n;
+        for (auto &x : a) x *= inv_n;
+    }
+}
+
+/**
+ * @brief 畳み込みを愚直に計算する。
+ * @return res[k] = Σ_{i+j=k} a[i] b[j] 。どちらかが空なら空。
+ * @details 計算量は O(|a||b|) 。列が短いときは NTT より速い。
+ */
+template <typename T>
+std::vector<T> convolution_naive(std::vector<T> const &a,
+                                 std::vector<T> const &b) {
+    int n = a.size(), m = b.size();
+    if (n == 0 || m == 0) return {};
+    std::vector<T> res(n + m - 1);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < m; j++) res[i + j] += a[i] * b[j];
+    return res;
+}
+
+template <ll MOD>
+std::vector<modint<MOD>>
+convolution_arbitrary(std::vector<modint<MOD>> const &a,
+                      std::vector<modint<MOD>> const &b);
+
+/**
+ * @brief NTT による畳み込み
+ * @return res[k] = Σ_{i+j=k} a[i] b[j] 。どちらかが空なら空。
+ * @details 結果の長さ以上の 2 の冪に 0 を詰めて伸ばし、両方を NTT して各点
+ * で掛けてから逆変換する。計算量は O((n + m) log(n + m)) 。短い方が 60 以下
+ * なら convolution_naive() の方が速いのでそちらを使う。 MOD - 1 が伸ばした長
+ * さで割り切れない (MOD が NTT-friendly でない) ときは、
+ * convolution_arbitrary() で三つの素数の NTT から求める。
+ */
+template <ll MOD>
+std::vector<modint<MOD>> convolution(std::vector<modint<MOD>> a,
+                                     std::vector<modint<MOD>> b) {
+    int n = a.size(), m = b.size();
+    if (n == 0 || m == 0) return {};
+    if (std::min(n, m) <= 60) return convolution_naive(a, b);
+
+    int z = 1;
+    while (z < n + m - 1) z *= 2;
+    if (z > ntt_max_len(MOD)) return convolution_arbitrary(a, b);
+    a.resize(z);
+    b.resize(z);
+    ntt(a);
+    ntt(b);
+    for (int i = 0; i < z; i++) a[i] *= b[i];
+    ntt(a, true);
+    a.resize(n + m - 1);
+    return a;
+}
+
+/**
+ * @brief a, b の P を法とする畳み込みを、使い回すバッファ上で計算する。
+ * @return 結果 (長さ |a| + |b| - 1) が入ったバッファへの参照。次に同じ P で
+ * 呼び出すまで有効。
+ * @details 要素は static_cast<ll> したものを P で割った余りとして扱うので、
+ * T は ll でも modint でもよい。バッファはスレッドごとに一つ持ち、 assign()
+ * で中身だけ書き換えるので、一度確保した容量は次の呼び出しでも再利用され
+ * る。
+ */
+template <ll P, typename T>
+std::vector<modint<P>> const &convolution_buffered(std::vector<T> const &a,
+                                                   std::vector<T> const &b) {
+    static thread_local std::vector<modint<P>> fa, fb;
+    int n = a.size(), m = b.size();
+    int z = 1;
+    while (z < n + m - 1) z *= 2;
+
+    fa.assign(z, 0);
+    fb.assign(z, 0);
+    for (int i = 0; i < n; i++) fa[i] = static_cast<ll>(a[i]);
+    for (int i = 0; i < m; i++) fb[i] = static_cast<ll>(b[i]);
+    ntt(fa);
+    ntt(fb);
+    for (int i = 0; i < z; i++) fa[i] *= fb[i];
+    ntt(fa, true);
+    fa.resize(n + m - 1);
+    return fa;
+}
+
+/**
+ * @brief 三つの NTT-friendly な素数で畳み込みを計算し、各項を復元する。
+ * @param[in] f 各 k について f(k, x) が呼ばれる。 x は結果の k 項目を
+ * M = 754974721 * 167772161 * 469762049 (約 2^86) で割った余り (__int128) 。
+ * @details 三つの素数での余りから、 Garner のアルゴリズムで M を法とする値を
+ * 復元する。途中の積は 128 bit で計算する。長さは 2^24 まで。
+ */
+template <typename T, typename F>
+void convolution_three_primes(std::vector<T> const &a,
+                              std::vector<T> const &b, F f) {
+    constexpr ll m1 = 754974721, m2 = 167772161, m3 = 469762049;
+    static ll const inv_m1_m2   = inv_mod(m1, m2);
+    static ll const inv_m1m2_m3 = inv_mod(m1 * m2 % m3, m3);
+
+    auto const &c1 = convolution_buffered<m1>(a, b);
+    auto const &c2 = convolution_buffered<m2>(a, b);
+    auto const &c3 = convolution_buffered<m3>(a, b);
+    for (int k = 0; k < static_cast<int>(c1.size()); k++) {
+        ll r1 = static_cast<ll>(c1[k]), r2 = static_cast<ll>(c2[k]),
+           r3 = static_cast<ll>(c3[k]);
+        // x = r1 + m1 t1 + m1 m2 t2 として t1, t2 を順に決める。
+        ll t1 = (r2 - r1 % m2 + m2) % m2 * inv_m1_m2 % m2;
+        ll t2 = ((r3 - r1 % m3 - m1 % m3 * t1 % m3) % m3 + 2 * m3) % m3 *
+                inv_m1m2_m3 % m3;
+        f(k, r1 + static_cast<__int128>(m1) * t1 +
+                 static_cast<__int128>(m1) * m2 * t2);
+    }
+}
+
+/**
+ * @brief 任意の法での畳み込み
+ * @details MOD が NTT-friendly でなくても (1'000'000'007 など) 使える。三つ
+ * の素数で畳み込んで復元するので、各項の真の値 (< 長さ * MOD^2) が三素数の積
+ * 約 2^86 未満であればよい。 MOD が 2^31 程度、長さが 2^24 までなら十分。
+ * 作業用のバッファは呼び出しをまたいで再利用される。
+ */
+template <ll MOD>
+std::vector<modint<MOD>>
+convolution_arbitrary(std::vector<modint<MOD>> const &a,
+                      std::vector<modint<MOD>> const &b) {
+    int n = a.size(), m = b.size();
+    if (n == 0 || m == 0) return {};
+    if (std::min(n, m) <= 60) return convolution_naive(a, b);
+
+    std::vector<modint<MOD>> res(n + m - 1);
+    convolution_three_primes(a, b, [&](int k, __int128 x) {
+        res[k] = static_cast<ll>(x % MOD);
+    });
+    return res;
+}
+
+/**
+ * @brief 整数列の (剰余をとらない) 畳み込み
+ * @details 結果の各項が ll に収まるなら正確な値を返す。負の値を含んでもよい。
+ * 三つの素数で復元した値は三素数の積 M を法として正しいので、 M/2 以上なら
+ * M を引いて負の値に戻す。短いときの愚直な計算は ull の wrapping で行うので、
+ * 途中の和が溢れても最終的な値が収まっていれば正しい。
+ */
+inline std::vector<ll> convolution_ll(std::vector<ll> const &a,
+                                      std::vector<ll> const &b) {
+    int n = a.size(), m = b.size();
+    if (n == 0 || m == 0) return {};
+
+    std::vector<ll> res(n + m - 1);
+    if (std::min(n, m) <= 60) {
+        std::vector<ull> tmp(n + m - 1);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < m; j++)
+                tmp[i + j] += static_cast<ull>(a[i]) * static_cast<ull>(b[j]);
+        for (int k = 0; k < n + m - 1; k++) res[k] = tmp[k];
+        return res;
+    }
+
+    __int128 const M = static_cast<__int128>(754974721) * 167772161 *
+                       469762049;
+    convolution_three_primes(a, b, [&](int k, __int128 x) {
+        res[k] = static_cast<ll>(x >= M / 2 ? x - M : x);
+    });
+    return res;
+}
+
+} // namespace pcl
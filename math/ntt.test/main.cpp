@@ -0,0 +1,71 @@
+#include "prelude.hpp"
+
+#include "math/ntt.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+using mint998 = modint<998244353>;
+
+int main() {
+    int n, m;
+    cin >> n >> m;
+    vector<mint998> a(n), b(m);
+    cin >> a >> b;
+
+    auto c = convolution(a, b);
+    for (int i = 0; i < static_cast<int>(c.size()); i++) {
+        if (i != 0) cout << ' ';
+        cout << c[i];
+    }
+    cout << endl;
+
+    // 長い列でも愚直な畳み込みと一致する。
+    int len;
+    cin >> len;
+    vector<mint998> x(len), y(len + 7);
+    for (int i = 0; i < len; i++) x[i] = static_cast<ll>(i) * i + 1;
+    for (int i = 0; i < len + 7; i++) y[i] = 998244352ll - 3 * i;
+    cout << (convolution(x, y) == convolution_naive(x, y)) << endl;
+
+    // NTT-friendly でない法での畳み込み
+    vector<mint> p(len), q(len + 3);
+    for (int i = 0; i < len; i++) p[i] = P7 - 1 - i;
+    for (int i = 0; i < len + 3; i++) q[i] = static_cast<ll>(i) * 998244353;
+    cout << (convolution_arbitrary(p, q) == convolution_naive(p, q))
+         << (convolution(p, q) == convolution_naive(p, q)) << endl;
+
+    // 負の値を含む整数の畳み込み
+    vector<ll> s(len), t(len + 5);
+    for (int i = 0; i < len; i++) s[i] = (i % 2 ? -1 : 1) * (1ll << 31) + i;
+    for (int i = 0; i < len + 5; i++) t[i] = -(1ll << 20) * i + 7;
+    auto st = convolution_ll(s, t);
+    bool ok = st.size() == s.size() + t.size() - 1;
+    for (int k = 0; ok && k < static_cast<int>(st.size()); k++) {
+        ll sum = 0;
+        for (int i = max(0, k - len - 4); i <= min(k, len - 1); i++)
+            sum += s[i] * t[k - i];
+        ok &= st[k] == sum;
+    }
+    cout << ok << endl;
+    cout << convolution_ll({-3, 4}, {5, -6, 7}) << endl;
+
+    // 冪根のテーブルを初めて作る呼び出しが複数のスレッドで重なってもよい。
+    using mint469 = modint<469762049>;
+    vector<vector<mint469>> res(4);
+    vector<thread> ths;
+    for (int t = 0; t < 4; t++) {
+        ths.emplace_back([&, t] {
+            for (int k = 1; k <= len; k *= 2) {
+                vector<mint469> u(k + t, 3), v(k, t + 1);
+                res[t] = convolution(u, v);
+                if (res[t] != convolution_naive(u, v)) res[t].clear();
+            }
+        });
+    }
+    for (auto &th : ths) th.join();
+    for (auto const &r : res) cout << !r.empty();
+    cout << endl;
+}
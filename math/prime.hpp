@@ -0,0 +1,96 @@
+/**
+ * @file math/prime.hpp
+ * @brief 64 bit 整数の素因数分解 (Pollard の ρ 法) 。
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include "../math/alg.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace pcl {
+
+/**
+ * @brief Pollard の ρ 法 (Brent の変種) で n の非自明な約数を一つ見つける。
+ * @param[in] n 合成数
+ * @details 擬似乱数列 x -> x^2 + c (mod n) の周期を Brent の方法で検出する。
+ * |x - y| を m 個ずつ掛け合わせてから gcd をとることで gcd の回数を減らし、
+ * まとめすぎて n 自身が出てきたときだけ一つずつやり直す。失敗したら c を変え
+ * て再試行する。期待計算量は O(n^(1/4)) 回の乗算。
+ */
+inline ull pollard_rho(ull n) {
+    if (n % 2 == 0) return 2;
+
+    // 一回の gcd でまとめる個数
+    ull const m = 128;
+    for (ull c = 1;; c++) {
+        auto f = [n, c](ull x) {
+            return static_cast<ull>((static_cast<__uint128_t>(x) * x + c) %
+                                    n);
+        };
+        auto diff = [](ull a, ull b) { return a > b ? a - b : b - a; };
+
+        ull x = 0, y = 2, ys = 2, q = 1, g = 1;
+        for (ull r = 1; g == 1; r <<= 1) {
+            x = y;
+            for (ull i = 0; i < r; i++) y = f(y);
+            for (ull k = 0; k < r && g == 1; k += m) {
+                ys = y;
+                for (ull i = 0; i < std::min(m, r - k); i++) {
+                    y = f(y);
+                    q = mul_mod(q, diff(x, y), n);
+                }
+                g = gcd(q, n);
+            }
+        }
+        if (g == n) {
+            do {
+                ys = f(ys);
+                g  = gcd(diff(x, ys), n);
+            } while (g == 1);
+        }
+        if (g != n) return g;
+    }
+}
+
+/**
+ * @brief n (>= 1) を素因数分解する。
+ * @return (素因数, 指数) のリスト。素因数の昇順。
+ * @details 小さい素因数は試し割りで先に取り除き、残りは is_prime() で素数判
+ * 定しながら pollard_rho() で分解していく。 N 以下の数を何度も分解するなら
+ * linear_sieve の方が速い。
+ */
+inline std::vector<std::pair<ull, int>> factorize(ull n) {
+    std::vector<ull> ps;
+    for (ull p = 2; p < 128 && p * p <= n; p += (p == 2 ? 1 : 2)) {
+        while (n % p == 0) ps.push_back(p), n /= p;
+    }
+
+    std::vector<ull> stack;
+    if (n > 1) stack.push_back(n);
+    while (!stack.empty()) {
+        ull x = stack.back();
+        stack.pop_back();
+        if (is_prime(x)) {
+            ps.push_back(x);
+        } else {
+            ull d = pollard_rho(x);
+            stack.push_back(d);
+            stack.push_back(x / d);
+        }
+    }
+    std::sort(ps.begin(), ps.end());
+
+    std::vector<std::pair<ull, int>> res;
+    for (ull p : ps) {
+        if (res.empty() || res.back().first != p) res.emplace_back(p, 0);
+        res.back().second++;
+    }
+    return res;
+}
+
+} // namespace pcl
@@ -0,0 +1,26 @@
+#include "prelude.hpp"
+
+#include "math/prime.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+// コンパイル時にも判定できる。
+static_assert(is_prime(998244353), "");
+static_assert(!is_prime(3215031751ll), "");
+
+int main() {
+    int q;
+    cin >> q;
+    for (int i = 0; i < q; i++) {
+        ull n;
+        cin >> n;
+        cout << n << ": " << is_prime(n);
+        for (auto const &pe : factorize(n)) {
+            cout << ' ' << pe.first << '^' << pe.second;
+        }
+        cout << endl;
+    }
+}
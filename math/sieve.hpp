@@ -0,0 +1,307 @@
+/**
+ * @file math/sieve.hpp
+ * @brief 篩による素数の列挙と素因数分解。
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include "../math/alg.hpp"
+#include "../util/thread_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace pcl {
+
+/**
+ * @brief 線形篩 (Euler の篩)
+ * @details 各合成数 x を「最小素因数 p と x/p の積」としてちょうど一回ずつ
+ * 篩うので、計算量は O(N) 。同時に各数の最小素因数を記録するため、 N 以下の
+ * 数の素因数分解が O(log x) でできる。また、メビウス関数 μ とオイラーの φ 関
+ * 数は乗法的関数なので、 x = p * (x/p) から同じループの中で計算できる。
+ */
+class linear_sieve {
+  private:
+    /// 篩の上限 (N を含む)
+    int n_;
+
+    /// spf_[x] は x の最小素因数 (x >= 2)
+    std::vector<int> spf_;
+
+    /// N 以下の素数の昇順のリスト
+    std::vector<int> primes_;
+
+    /// mobius_[x] は μ(x)
+    std::vector<signed char> mobius_;
+
+    /// totient_[x] は φ(x)
+    std::vector<int> totient_;
+
+  public:
+    /**
+     * @brief [0, n] について篩を行う。
+     * @param[in] n 上限 (n 自身も含む)
+     */
+    linear_sieve(int n)
+        : n_(n)
+        , spf_(n + 1, 0)
+        , mobius_(n + 1, 0)
+        , totient_(n + 1, 0) {
+        assert(n >= 1);
+        mobius_[1]  = 1;
+        totient_[1] = 1;
+        for (int i = 2; i <= n; i++) {
+            if (spf_[i] == 0) {
+                spf_[i] = i;
+                primes_.push_back(i);
+                mobius_[i]  = -1;
+                totient_[i] = i - 1;
+            }
+            for (int p : primes_) {
+                // i * p の最小素因数が p となる範囲だけ篩う。
+                if (p > spf_[i] || static_cast<ll>(i) * p > n) break;
+                int x   = i * p;
+                spf_[x] = p;
+                if (p == spf_[i]) {
+                    mobius_[x]  = 0;
+                    totient_[x] = totient_[i] * p;
+                } else {
+                    mobius_[x]  = -mobius_[i];
+                    totient_[x] = totient_[i] * (p - 1);
+                }
+            }
+        }
+    }
+
+    /// 篩の上限
+    int size() const {
+        return n_;
+    }
+
+    /// N 以下の素数の昇順のリスト
+    std::vector<int> const &primes() const {
+        return primes_;
+    }
+
+    /// x が素数かどうか
+    bool is_prime(int x) const {
+        assert(in_range(0, x, n_ + 1));
+        return x >= 2 && spf_[x] == x;
+    }
+
+    /// x (>= 2) の最小素因数
+    int spf(int x) const {
+        assert(in_range(2, x, n_ + 1));
+        return spf_[x];
+    }
+
+    /// メビウス関数 μ(x) (x >= 1)
+    int mobius(int x) const {
+        assert(in_range(1, x, n_ + 1));
+        return mobius_[x];
+    }
+
+    /// オイラーの φ 関数 φ(x) (x >= 1)
+    int totient(int x) const {
+        assert(in_range(1, x, n_ + 1));
+        return totient_[x];
+    }
+
+    /**
+     * @brief x (>= 1) を素因数分解する。
+     * @return (素因数, 指数) のリスト。素因数の昇順。
+     * @details 最小素因数で割り続けるだけなので O(log x) 。
+     */
+    std::vector<std::pair<int, int>> factorize(int x) const {
+        assert(in_range(1, x, n_ + 1));
+        std::vector<std::pair<int, int>> res;
+        while (x != 1) {
+            int p = spf_[x], e = 0;
+            while (x % p == 0) x /= p, e++;
+            res.emplace_back(p, e);
+        }
+        return res;
+    }
+};
+
+/**
+ * @brief 区間篩で、各素数について次に篩うビット位置を求める。
+ * @param[in] first 篩う奇数の最小値。 j ビット目が first + 2j を表す。
+ * @param[in] b ビット位置 b 以降で最初に篩う位置を求める。
+ * @param[in] base 奇素数の昇順のリスト
+ * @details p^2 未満の倍数はより小さい素数で篩われているので p^2 から始めれば
+ * よい。素数ごとに一回割り算をする。
+ */
+inline std::vector<ll> sieve_offsets_impl(ll first, ll b,
+                                          std::vector<int> const &base) {
+    ll lo = first + 2 * b;
+    std::vector<ll> next(base.size());
+    for (int k = 0; k < static_cast<int>(base.size()); k++) {
+        ll p = base[k];
+        ll s = std::max(p * p, (lo + p - 1) / p * p);
+        if (s % 2 == 0) s += p;
+        next[k] = (s - first) / 2;
+    }
+    return next;
+}
+
+/**
+ * @brief 区間篩で、ビット [b_begin, b_end) を篩って素数を昇順に f へ渡す。
+ * @param[inout] next sieve_offsets_impl() で求めた、各素数について次に篩う
+ * ビット位置。 b_end 以降の位置に更新される。
+ * @details 奇数のみを 1 ビットずつ持つ (wheel-2) ビット列を、 L1 キャッシュ
+ * に収まる 32KiB ずつのブロックに区切って篩う。 next をブロックをまたいで持
+ * ち越すので、ここでは割り算をしない。
+ */
+template <typename F>
+void sieve_bits_impl(ll first, ll b_begin, ll b_end,
+                     std::vector<int> const &base, std::vector<ll> &next,
+                     F &f) {
+    // 1 ブロックあたりのワード数 (32KiB) とビット数。
+    constexpr int block_words = 4096;
+    constexpr ll block_bits   = block_words * 64;
+
+    std::vector<ull> bits(block_words);
+    for (ll b0 = b_begin; b0 < b_end; b0 += block_bits) {
+        ll nb     = std::min(block_bits, b_end - b0);
+        int words = (nb + 63) / 64;
+        std::fill(bits.begin(), bits.begin() + words, 0);
+
+        for (int k = 0; k < static_cast<int>(base.size()); k++) {
+            ll p = base[k];
+            // これ以降の素数の p^2 はこのブロックより後ろにある。
+            if (p * p >= first + 2 * (b0 + nb)) break;
+            ll j = next[k] - b0;
+            for (; j < nb; j += p) bits[j >> 6] |= 1ull << (j & 63);
+            next[k] = b0 + j;
+        }
+
+        for (int w = 0; w < words; w++) {
+            ull m = ~bits[w];
+            if (w == words - 1 && nb % 64 != 0) m &= (1ull << (nb % 64)) - 1;
+            while (m != 0) {
+                ll j = b0 + w * 64 + __builtin_ctzll(m);
+                f(first + 2 * j);
+                m &= m - 1;
+            }
+        }
+    }
+}
+
+/**
+ * @brief segmented_sieve() の実体。 [lo, hi) の素数を昇順に f へ渡す。
+ * @param[in] base √hi 未満の奇素数の昇順のリスト
+ */
+template <typename F>
+void segmented_sieve_impl(ll lo, ll hi, std::vector<int> const &base,
+                          F &f) {
+    if (lo <= 2 && 2 < hi) f(2ll);
+
+    // first 以上 hi 未満の奇数を扱う。 j ビット目は first + 2j を表す。
+    ll first = std::max(lo, 3ll) | 1;
+    if (first >= hi) return;
+    ll count = (hi - first + 1) / 2;
+
+    auto next = sieve_offsets_impl(first, 0, base);
+    sieve_bits_impl(first, 0, count, base, next, f);
+}
+
+/**
+ * @brief 区間篩 - [L, R) の素数を昇順に列挙する。
+ * @param[in] L 区間の左端
+ * @param[in] R 区間の右端 (右端は区間に含まない)
+ * @param[in] f 素数 p ごとに f(p) が昇順に呼ばれる。
+ * @param[in] threads 使うスレッド数
+ * @details √R 未満の素数だけを先に求めておき、それを使って区間をキャッシュに
+ * 収まる大きさのブロックごとに篩う。メモリは O(√R) しか使わないので、 R が
+ * 10^12 程度でも R - L が現実的な大きさであれば列挙できる。計算量は
+ * O((R - L) log log R + √R) 。
+ * threads > 1 のときは、区間を 2^24 ずつに区切った塊を threads 個ずつ、篩の
+ * 間ずっと使う thread_pool で並列に篩う。スレッド t は塊 t, t + threads, ...
+ * を受け持ち、各素数の次に篩う位置を自分の次の塊へ持ち越す。飛ばす
+ * threads - 1 個の塊の長さを各素数で割った余りは最初に一度だけ求めておくの
+ * で、塊ごとに割り算をし直すことはない。見つかった素数は塊ごとに一旦溜めて
+ * から、呼び出し元のスレッドで順番に f へ渡すので、 f はスレッドセーフでなく
+ * てよい。
+ */
+template <typename F>
+void segmented_sieve(ll L, ll R, F f, int threads = 1) {
+    assert(0 <= L && L <= R);
+
+    // 篩うのに必要な素数は p^2 < R のもののみ。
+    ll s = std::sqrt(static_cast<double>(R));
+    while (s * s >= R && s > 0) s--;
+    while ((s + 1) * (s + 1) < R) s++;
+    std::vector<int> base;
+    for (int p : sieve<int>(s)) {
+        if (p != 2) base.push_back(p);
+    }
+
+    if (threads <= 1) {
+        segmented_sieve_impl(L, R, base, f);
+        return;
+    }
+
+    if (L <= 2 && 2 < R) f(2ll);
+    ll first = std::max(L, 3ll) | 1;
+    if (first >= R) return;
+    ll count = (R - first + 1) / 2;
+
+    // 塊のビット数 (2^24 個の整数) と、スレッドが次の塊へ飛ばすビット数
+    ll const chunk = 1ll << 23, gap = chunk * (threads - 1);
+    int const nb   = base.size();
+
+    // gap を足してから add[k] を足すと、 base[k] を法として元に戻る。
+    std::vector<ll> add(nb);
+    for (int k = 0; k < nb; k++) add[k] = (base[k] - gap % base[k]) % base[k];
+
+    thread_pool pool(threads);
+    std::vector<std::vector<ll>> found(threads), next(threads);
+    pool.run([&](int t) {
+        next[t] = sieve_offsets_impl(first, std::min(count, chunk * t), base);
+    });
+
+    for (ll lo = 0; lo < count; lo += chunk * threads) {
+        pool.run([&](int t) {
+            found[t].clear();
+            ll b = lo + chunk * t, e = std::min(count, b + chunk);
+            if (b >= e) return;
+            auto push = [&](ll p) { found[t].push_back(p); };
+            sieve_bits_impl(first, b, e, base, next[t], push);
+
+            // next[t][k] を、次の塊の先頭 e + gap 以降の最初の位置に進める。
+            ll start = e + gap;
+            for (int k = 0; k < nb; k++) {
+                ll p = base[k], &j = next[t][k];
+                if (j >= start) continue;
+                if (j < e + p) {
+                    // この塊で篩ったので e <= j < e + p 。
+                    j += gap + add[k];
+                    if (j - p >= start) j -= p;
+                } else {
+                    // p^2 が飛ばす塊の中にある。素数ごとに高々一回。
+                    j += (start - j + p - 1) / p * p;
+                }
+            }
+        });
+        for (auto const &ps : found) {
+            for (ll p : ps) f(p);
+        }
+    }
+}
+
+/**
+ * @brief [L, R) の素数を昇順に全て求める。
+ * @details segmented_sieve() の結果を集めるだけ。
+ */
+inline std::vector<ll> primes_in_range(ll L, ll R, int threads = 1) {
+    std::vector<ll> res;
+    segmented_sieve(L, R, [&](ll p) { res.push_back(p); }, threads);
+    return res;
+}
+
+} // namespace pcl
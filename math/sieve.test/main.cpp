@@ -0,0 +1,34 @@
+#include "prelude.hpp"
+
+#include "math/sieve.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+int main() {
+    int n, q;
+    cin >> n >> q;
+    linear_sieve ls(n);
+
+    cout << ls.primes().size() << endl;
+    for (int i = 0; i < q; i++) {
+        int x;
+        cin >> x;
+        cout << x << ':';
+        for (auto const &pe : ls.factorize(x)) {
+            for (int j = 0; j < pe.second; j++) cout << ' ' << pe.first;
+        }
+        cout << endl;
+        cout << ls.is_prime(x) << ' ' << ls.mobius(x) << ' ' << ls.totient(x)
+             << endl;
+    }
+
+    ll L, R;
+    cin >> L >> R;
+    auto ps = primes_in_range(L, R);
+    cout << ps.size() << endl;
+    if (!ps.empty()) cout << ps.front() << ' ' << ps.back() << endl;
+    cout << (ps == primes_in_range(L, R, 4)) << endl;
+}
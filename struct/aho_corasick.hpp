@@ -0,0 +1,219 @@
+/**
+ * @file struct/aho_corasick.hpp
+ * @brief Aho-Corasick 法による複数パターンの文字列検索
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+namespace pcl {
+
+/**
+ * @brief Aho-Corasick 法による複数パターンの文字列検索
+ * @details パターンたちの Trie に失敗リンクを張ったオートマトンを作り、テキス
+ * トを一度なめるだけで全てのパターンの出現を見つける。計算量は構築が O(パタ
+ * ーン長の総和 * alpha) 、検索が O(|text| + 出現数) 。
+ * 遷移表は `ノード数 * alpha` の平坦な配列で持ち、構築時にノードを BFS 順に
+ * 振り直すので、浅いノード (よく通る) ほど表の先頭に集まる。文字は `base` か
+ * ら始まる連続した `alpha` 種類でなければならない。任意のバイト列を扱うなら
+ * `aho_corasick<256, 0>` とすればよい。
+ */
+template <int alpha = 26, char base = 'a'>
+class aho_corasick {
+  private:
+    /// 遷移表。 next_[v * alpha + c] は v から文字 c で進んだ先。
+    /// build() の前は Trie の辺のみ (なければ -1) 、後は失敗遷移込み。
+    std::vector<int> next_;
+
+    /// 失敗リンク
+    std::vector<int> fail_;
+
+    /// 出力リンク: 失敗リンクを辿って最初に見つかる、パターンが終わるノード
+    /// (なければ -1) 。
+    std::vector<int> dict_;
+
+    /// ノード v で終わるパターンは term_[term_begin_[v]..term_begin_[v+1]] 。
+    std::vector<int> term_begin_, term_;
+
+    /// パターン i の長さ
+    std::vector<int> len_;
+
+    /// パターン i が終わるノード
+    std::vector<int> node_of_;
+
+    /// build() 済みかどうか
+    bool built_;
+
+    /// 文字を遷移表の添字に変換する。
+    static int index(char c) {
+        int i = static_cast<unsigned char>(c) -
+                static_cast<unsigned char>(base);
+        assert(in_range(0, i, alpha));
+        return i;
+    }
+
+    /// ノード v でパターンが終わるかどうか。
+    bool is_term(int v) const {
+        return term_begin_[v] != term_begin_[v + 1];
+    }
+
+  public:
+    /// 空のオートマトンを作る。
+    aho_corasick()
+        : next_(alpha, -1)
+        , built_(false) {
+    }
+
+    /// パターンの列から構築する。 build() まで行う。
+    aho_corasick(std::vector<std::string> const &patterns)
+        : aho_corasick() {
+        for (auto const &p : patterns) add(p);
+        build();
+    }
+
+    /// ノード数
+    int size() const {
+        return next_.size() / alpha;
+    }
+
+    /// パターン数
+    int count_patterns() const {
+        return len_.size();
+    }
+
+    /**
+     * @brief パターンを追加する。
+     * @return パターンの番号 (追加した順に 0, 1, ...)
+     * @details build() の前でなければならない。空文字列は追加できない。
+     */
+    int add(std::string const &p) {
+        assert(!built_);
+        assert(!p.empty());
+        int v = 0;
+        for (char ch : p) {
+            int c = index(ch);
+            if (next_[v * alpha + c] == -1) {
+                next_[v * alpha + c] = size();
+                next_.resize(next_.size() + alpha, -1);
+            }
+            v = next_[v * alpha + c];
+        }
+        len_.push_back(p.size());
+        node_of_.push_back(v);
+        return len_.size() - 1;
+    }
+
+    /**
+     * @brief 失敗リンクを計算してオートマトンを完成させる。
+     * @details ノード番号を BFS 順に振り直してから、 BFS 順に失敗リンクと遷
+     * 移表を埋めていく。 BFS 順では fail_[v] < v なので、 v を処理するとき
+     * には fail_[v] の遷移は既に完成している。
+     */
+    void build() {
+        assert(!built_);
+        built_ = true;
+        int n = size();
+
+        // BFS 順を求めて番号を振り直す。
+        std::vector<int> order(1, 0), renum(n);
+        for (int i = 0; i < static_cast<int>(order.size()); i++) {
+            int v    = order[i];
+            renum[v] = i;
+            for (int c = 0; c < alpha; c++) {
+                int u = next_[v * alpha + c];
+                if (u != -1) order.push_back(u);
+            }
+        }
+        std::vector<int> next(n * alpha);
+        for (int i = 0; i < n; i++) {
+            for (int c = 0; c < alpha; c++) {
+                int u = next_[order[i] * alpha + c];
+                next[i * alpha + c] = u == -1 ? -1 : renum[u];
+            }
+        }
+        next_ = std::move(next);
+        for (int &v : node_of_) v = renum[v];
+
+        // 各ノードで終わるパターンを CSR 形式で持つ。
+        term_begin_.assign(n + 1, 0);
+        for (int v : node_of_) term_begin_[v + 1]++;
+        for (int v = 0; v < n; v++) term_begin_[v + 1] += term_begin_[v];
+        term_.resize(node_of_.size());
+        {
+            std::vector<int> pos(term_begin_.begin(), term_begin_.end() - 1);
+            for (int i = 0; i < count_patterns(); i++) {
+                term_[pos[node_of_[i]]++] = i;
+            }
+        }
+
+        // 失敗リンクと遷移表を埋める。
+        fail_.assign(n, 0);
+        dict_.assign(n, -1);
+        for (int v = 0; v < n; v++) {
+            if (v != 0) {
+                int f    = fail_[v];
+                dict_[v] = is_term(f) ? f : dict_[f];
+            }
+            for (int c = 0; c < alpha; c++) {
+                int &u = next_[v * alpha + c];
+                int fu = v == 0 ? 0 : next_[fail_[v] * alpha + c];
+                if (u == -1) {
+                    u = fu;
+                } else {
+                    fail_[u] = fu;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief テキスト中の全てのパターンの出現を列挙する。
+     * @param[in] text テキスト
+     * @param[in] f 出現ごとに f(開始位置, パターン番号) が呼ばれる。呼ばれる
+     * 順番は終了位置の昇順。
+     * @details 計算量は O(|text| + 出現数) 。
+     */
+    template <typename F>
+    void match(std::string const &text, F f) const {
+        assert(built_);
+        int v = 0;
+        for (int i = 0; i < static_cast<int>(text.size()); i++) {
+            v = next_[v * alpha + index(text[i])];
+            for (int u = is_term(v) ? v : dict_[v]; u != -1; u = dict_[u]) {
+                for (int j = term_begin_[u]; j < term_begin_[u + 1]; j++) {
+                    int id = term_[j];
+                    f(i + 1 - len_[id], id);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief テキスト中の各パターンの出現回数を求める。
+     * @return res[i] はパターン i の出現回数
+     * @details 出現を一つ一つ列挙せず、到達したノードの回数を失敗リンクの木
+     * に沿って集計する。計算量は O(|text| + ノード数) で、出現数に依存しな
+     * い。
+     */
+    std::vector<ll> count(std::string const &text) const {
+        assert(built_);
+        std::vector<ll> visited(size(), 0);
+        int v = 0;
+        for (char ch : text) visited[v = next_[v * alpha + index(ch)]]++;
+
+        // BFS 順の逆順に処理すれば、子から親へと集計できる。
+        for (int u = size() - 1; u > 0; u--) visited[fail_[u]] += visited[u];
+
+        std::vector<ll> res(count_patterns());
+        for (int i = 0; i < count_patterns(); i++) {
+            res[i] = visited[node_of_[i]];
+        }
+        return res;
+    }
+};
+
+} // namespace pcl
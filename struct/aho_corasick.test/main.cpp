@@ -0,0 +1,31 @@
+#include "prelude.hpp"
+
+#include "struct/aho_corasick.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+int main() {
+    int n;
+    cin >> n;
+    vector<string> ps(n);
+    for (auto &p : ps) cin >> p;
+    string text;
+    cin >> text;
+
+    aho_corasick<> ac(ps);
+
+    vector<pair<int, int>> found;
+    ac.match(text, [&](int pos, int id) { found.emplace_back(pos, id); });
+    sort(found.begin(), found.end());
+    for (auto const &f : found) cout << f.first << ' ' << f.second << endl;
+
+    auto cnt = ac.count(text);
+    for (int i = 0; i < n; i++) {
+        if (i != 0) cout << ' ';
+        cout << cnt[i];
+    }
+    cout << endl;
+}
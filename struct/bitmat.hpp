@@ -0,0 +1,236 @@
+/**
+ * @file struct/bitmat.hpp
+ * @brief GF(2) 上の行列 (各行をビット列に詰めたもの)
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace pcl {
+
+/**
+ * @brief GF(2) 上の h x w 行列
+ * @details 各行を 64 bit ごとに ull に詰め、全ての行を一つの連続した領域に
+ * 並べて持つ。 (i, j) 成分は i 行目の j / 64 語目の j % 64 ビット目。
+ * mat<int> に比べてメモリは 1/32 で、行の足し算 (xor) は語単位でまとめて行え
+ * るので、消去法は O(h w min(h, w) / 64) になる。行の xor は単純な語のルー
+ * プなのでベクトル化される。
+ */
+class bitmat {
+  private:
+    int h_, w_;
+
+    /// 一行の語数
+    int words_;
+
+    std::vector<ull> v_;
+
+    /**
+     * @brief in-place に被約行階段形にする。
+     * @param[in] lim 先頭 lim 列からだけ枢軸を選ぶ。
+     * @return 枢軸のある列の番号のリスト。長さが階数になる。
+     */
+    std::vector<int> eliminate(int lim) {
+        std::vector<int> piv;
+        for (int c = 0, r = 0; c < lim && r < h_; c++) {
+            int wc = c / 64;
+            ull b  = 1ull << (c % 64);
+            int p  = r;
+            while (p < h_ && !((*this)[p][wc] & b)) p++;
+            if (p == h_) continue;
+            if (p != r) {
+                std::swap_ranges((*this)[p], (*this)[p] + words_, (*this)[r]);
+            }
+
+            // c 列目より左の語は枢軸の行では全て 0 なので、 wc 語目から xor
+            // すればよい。
+            ull const *pr = (*this)[r];
+            for (int i = 0; i < h_; i++) {
+                if (i == r || !((*this)[i][wc] & b)) continue;
+                ull *ri = (*this)[i];
+                for (int k = wc; k < words_; k++) ri[k] ^= pr[k];
+            }
+            piv.push_back(c);
+            r++;
+        }
+        return piv;
+    }
+
+  public:
+    /// h x w の零行列
+    bitmat(int h, int w)
+        : h_(h)
+        , w_(w)
+        , words_((w + 63) / 64)
+        , v_(static_cast<std::size_t>(h) * words_) {
+        assert(h >= 0 && w >= 0);
+    }
+
+    /// '0' と '1' からなる文字列を各行として作る。
+    bitmat(std::vector<std::string> const &rows)
+        : bitmat(rows.size(), rows.empty() ? 0 : rows[0].size()) {
+        for (int i = 0; i < h_; i++) {
+            // matrix initializer has incompatible size: the number of cols
+            // differs row by row.
+            assert(static_cast<int>(rows[i].size()) == w_);
+            for (int j = 0; j < w_; j++) set(i, j, rows[i][j] == '1');
+        }
+    }
+
+    /// n 次の単位行列
+    static bitmat identity(int n) {
+        bitmat res(n, n);
+        for (int i = 0; i < n; i++) res.set(i, i, true);
+        return res;
+    }
+
+    int height() const {
+        return h_;
+    }
+
+    int width() const {
+        return w_;
+    }
+
+    bool get(int i, int j) const {
+        assert(in_range(0, i, h_));
+        assert(in_range(0, j, w_));
+        return (*this)[i][j / 64] >> (j % 64) & 1;
+    }
+
+    void set(int i, int j, bool x) {
+        assert(in_range(0, i, h_));
+        assert(in_range(0, j, w_));
+        ull b = 1ull << (j % 64);
+        if (x) {
+            (*this)[i][j / 64] |= b;
+        } else {
+            (*this)[i][j / 64] &= ~b;
+        }
+    }
+
+    void flip(int i, int j) {
+        assert(in_range(0, i, h_));
+        assert(in_range(0, j, w_));
+        (*this)[i][j / 64] ^= 1ull << (j % 64);
+    }
+
+    /// i 行目の先頭の語へのポインタ。範囲の検査はしない。
+    ull const *operator[](int i) const {
+        return v_.data() + static_cast<std::size_t>(i) * words_;
+    }
+
+    ull *operator[](int i) {
+        return v_.data() + static_cast<std::size_t>(i) * words_;
+    }
+
+    /// dst 行目に src 行目を足す (xor する) 。
+    void xor_row(int dst, int src) {
+        assert(in_range(0, dst, h_));
+        assert(in_range(0, src, h_));
+        ull *d = (*this)[dst];
+        ull const *s = (*this)[src];
+        for (int k = 0; k < words_; k++) d[k] ^= s[k];
+    }
+
+    /// 階数
+    int rank() const {
+        bitmat a = *this;
+        return a.eliminate(w_).size();
+    }
+
+    /**
+     * @brief 連立一次方程式 A x = b (GF(2)) の解の一つ
+     * @param[in] b 各成分が 0 か 1 の、長さ h の列
+     * @return 解の一つ (自由変数は 0 にしたもの) 。解がなければ空。
+     */
+    std::vector<char> solve(std::vector<char> const &b) const {
+        assert(static_cast<int>(b.size()) == h_);
+
+        // 拡大係数行列 (A | b)
+        bitmat a(h_, w_ + 1);
+        for (int i = 0; i < h_; i++) {
+            std::copy((*this)[i], (*this)[i] + words_, a[i]);
+            a.set(i, w_, b[i]);
+        }
+        auto piv = a.eliminate(w_);
+        int rank = piv.size();
+        for (int i = rank; i < h_; i++) {
+            if (a.get(i, w_)) return {};
+        }
+
+        std::vector<char> x(w_);
+        for (int i = 0; i < rank; i++) x[piv[i]] = a.get(i, w_);
+        return x;
+    }
+
+    /**
+     * @brief 核 (A x = 0 の解空間) の基底
+     * @return 各行が基底のベクトルである (w - rank) x w 行列
+     * @details 被約行階段形で、自由変数を一つだけ 1 にしたときの解を並べる。
+     */
+    bitmat kernel() const {
+        bitmat a = *this;
+        auto piv = a.eliminate(w_);
+        std::vector<char> is_piv(w_);
+        for (int c : piv) is_piv[c] = true;
+
+        bitmat res(w_ - piv.size(), w_);
+        for (int f = 0, k = 0; f < w_; f++) {
+            if (is_piv[f]) continue;
+            res.set(k, f, true);
+            for (int i = 0; i < static_cast<int>(piv.size()); i++) {
+                if (a.get(i, f)) res.set(k, piv[i], true);
+            }
+            k++;
+        }
+        return res;
+    }
+};
+
+/// 積 (GF(2)) 。 a の i 行目で立っているビットに対応する b の行を xor する。
+inline bitmat operator*(bitmat const &a, bitmat const &b) {
+    // assert size restriction: otherwise they're incompatible for *.
+    assert(a.width() == b.height());
+
+    int words = (b.width() + 63) / 64;
+    bitmat res(a.height(), b.width());
+    for (int i = 0; i < a.height(); i++) {
+        ull *r = res[i];
+        for (int k = 0; k < a.width(); k++) {
+            if (!a.get(i, k)) continue;
+            ull const *bk = b[k];
+            for (int j = 0; j < words; j++) r[j] ^= bk[j];
+        }
+    }
+    return res;
+}
+
+inline bool operator==(bitmat const &a, bitmat const &b) {
+    assert(a.height() == b.height());
+    assert(a.width() == b.width());
+    int words = (a.width() + 63) / 64;
+    return std::equal(a[0], a[0] + a.height() * words, b[0]);
+}
+
+inline bool operator!=(bitmat const &a, bitmat const &b) {
+    return !(a == b);
+}
+
+/// ストリーム出力演算子。各行を 0 と 1 の列として改行区切りで出力する。
+inline std::ostream &operator<<(std::ostream &os, bitmat const &m) {
+    for (int i = 0; i < m.height(); i++) {
+        if (i != 0) os << '\n';
+        for (int j = 0; j < m.width(); j++) os << (m.get(i, j) ? '1' : '0');
+    }
+    return os;
+}
+
+} // namespace pcl
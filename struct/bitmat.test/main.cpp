@@ -0,0 +1,106 @@
+#include "prelude.hpp"
+
+#include "struct/bitmat.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+/// 定義通りに 0/1 の二次元配列で消去したときの階数
+int rank_naive(vector<vector<int>> a) {
+    int h = a.size(), w = h == 0 ? 0 : a[0].size(), r = 0;
+    for (int c = 0; c < w && r < h; c++) {
+        int p = r;
+        while (p < h && a[p][c] == 0) p++;
+        if (p == h) continue;
+        swap(a[p], a[r]);
+        for (int i = 0; i < h; i++) {
+            if (i == r || a[i][c] == 0) continue;
+            for (int j = 0; j < w; j++) a[i][j] ^= a[r][j];
+        }
+        r++;
+    }
+    return r;
+}
+
+/// A x (GF(2))
+vector<char> apply(bitmat const &a, vector<char> const &x) {
+    vector<char> res(a.height());
+    for (int i = 0; i < a.height(); i++)
+        for (int j = 0; j < a.width(); j++) res[i] ^= a.get(i, j) & x[j];
+    return res;
+}
+
+/// 語の境界をまたぐ大きさで、階数・解・核が定義を満たすか。
+bool check_random(int h, int w, int r) {
+    mt19937_64 rng(h * 1000 + w);
+
+    // 階数が高々 r になるように、 h x r と r x w の積で作る。
+    bitmat l(h, r), u(r, w);
+    for (int i = 0; i < h; i++)
+        for (int k = 0; k < r; k++) l.set(i, k, rng() & 1);
+    for (int k = 0; k < r; k++)
+        for (int j = 0; j < w; j++) u.set(k, j, rng() & 1);
+    bitmat a = l * u;
+
+    vector<vector<int>> naive(h, vector<int>(w));
+    for (int i = 0; i < h; i++)
+        for (int j = 0; j < w; j++) naive[i][j] = a.get(i, j);
+    int rank = a.rank();
+    if (rank != rank_naive(naive)) return false;
+
+    vector<char> x0(w);
+    for (auto &x : x0) x = rng() & 1;
+    auto b = apply(a, x0);
+    auto x = a.solve(b);
+    if (static_cast<int>(x.size()) != w || apply(a, x) != b) return false;
+
+    bitmat k = a.kernel();
+    if (k.height() != w - rank || k.rank() != w - rank) return false;
+    for (int i = 0; i < k.height(); i++) {
+        vector<char> v(w);
+        for (int j = 0; j < w; j++) v[j] = k.get(i, j);
+        if (apply(a, v) != vector<char>(h)) return false;
+    }
+
+    // 階数が落ちていれば、像に入らない b では解がない。
+    if (rank < h) {
+        for (int t = 0; t < 10; t++) {
+            vector<char> c(h);
+            for (auto &y : c) y = rng() & 1;
+            auto y = a.solve(c);
+            if (!y.empty() && apply(a, y) != c) return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    int h, w;
+    cin >> h >> w;
+    vector<string> rows(h);
+    for (auto &r : rows) cin >> r;
+    vector<char> b(h);
+    for (auto &x : b) {
+        int y;
+        cin >> y;
+        x = y;
+    }
+
+    bitmat a(rows);
+    cout << a.rank() << endl;
+    auto x = a.solve(b);
+    if (x.empty()) {
+        cout << "no solution" << endl;
+    } else {
+        for (int j = 0; j < w; j++) cout << int(x[j]) << " \n"[j == w - 1];
+    }
+    cout << a.kernel() << endl;
+    cout << (a * bitmat::identity(w) == a) << endl;
+
+    cout << check_random(70, 130, 50) << endl;
+    cout << check_random(130, 70, 70) << endl;
+    cout << check_random(200, 200, 199) << endl;
+    cout << check_random(64, 64, 64) << endl;
+}
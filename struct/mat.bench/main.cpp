@@ -0,0 +1,131 @@
+/// ベンチマーク: 行列の積のブロック化の効果と、積と冪のスレッド数による速さ
+/// 使い方: ./a.out [最大スレッド数 (既定 32)] [愚直な積を測る最大の n (既定
+/// 1024)] > bench_output.txt
+
+#include "prelude.hpp"
+
+#include "struct/mat.hpp"
+#include "util/thread_pool.hpp"
+#include "wrapper/modint.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+/// f() を reps 回実行した中で最短の時間 (秒)
+template <typename F>
+double seconds(F const &f, int reps = 3) {
+    double best = 1e18;
+    for (int r = 0; r < reps; r++) {
+        auto start = chrono::steady_clock::now();
+        f();
+        chrono::duration<double> d = chrono::steady_clock::now() - start;
+        best = min(best, d.count());
+    }
+    return best;
+}
+
+template <typename T>
+mat<T> random_mat(int n, mt19937_64 &rng) {
+    mat<T> a(n, n);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++) a.at(i, j) = static_cast<ll>(rng() % P7);
+    return a;
+}
+
+template <>
+mat<double> random_mat(int n, mt19937_64 &rng) {
+    mat<double> a(n, n);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            a.at(i, j) = uniform_real_distribution<>(-1, 1)(rng);
+    return a;
+}
+
+/// 定義通りの i-j-k 順の O(n^3) の積
+template <typename T>
+void mul_naive(mat<T> const &a, mat<T> const &b, mat<T> &res) {
+    int n = a.height();
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            T sum{};
+            for (int k = 0; k < n; k++) sum += a.at(i, k) * b.at(k, j);
+            res.at(i, j) = sum;
+        }
+    }
+}
+
+/// n = 256, ..., 2048 で、愚直な積とブロック化した積 (一スレッド) を比べる。
+template <typename T>
+void bench_blocked(string const &name, int naive_max) {
+    for (int n = 256; n <= 2048; n *= 2) {
+        mt19937_64 rng(n);
+        auto a = random_mat<T>(n, rng), b = random_mat<T>(n, rng);
+        mat<T> c(n, n);
+        int reps       = n >= 1024 ? 1 : 3;
+        double blocked = seconds([&] { mul_into(a, b, c); }, reps);
+        if (n <= naive_max) {
+            double naive = seconds([&] { mul_naive(a, b, c); }, reps);
+            printf("mul %-6s n=%4d naive %8.4fs blocked %8.4fs (x%.1f)\n",
+                   name.c_str(), n, naive, blocked, naive / blocked);
+        } else {
+            printf("mul %-6s n=%4d naive        - blocked %8.4fs\n",
+                   name.c_str(), n, blocked);
+        }
+    }
+}
+
+/// n x n の積をスレッド数 1, 2, 4, ..., max_threads で測る。
+template <typename T>
+void bench_threads(string const &name, int n, int max_threads) {
+    mt19937_64 rng(n);
+    auto a = random_mat<T>(n, rng), b = random_mat<T>(n, rng);
+    mat<T> c(n, n);
+    double base = 0;
+    for (int t = 1; t <= max_threads; t *= 2) {
+        thread_pool pool(t);
+        double s = seconds([&] { mul_into(a, b, c, pool); });
+        if (t == 1) base = s;
+        printf("mul %-6s n=%4d threads=%2d %8.4fs speedup %5.2f\n",
+               name.c_str(), n, t, s, base / s);
+    }
+}
+
+/**
+ * 小さい行列の大きな冪では掛け算が約 120 回になる。毎回スレッドを作る場合
+ * (掛け算ごとに mul_into(..., int threads)) と、一つの thread_pool を使い回
+ * す場合 (pow(..., threads)) を比べる。
+ */
+void bench_pow(int n, int max_threads) {
+    mt19937_64 rng(n);
+    auto x      = random_mat<mint>(n, rng);
+    ull const e = 1'000'000'000'000'000'000ull;
+    for (int t = 1; t <= max_threads; t *= 2) {
+        double spawn = seconds([&] {
+            mat<mint> res = mat<mint>::identity(n), y = x, tmp(n, n);
+            for (ull k = e; k > 0; k >>= 1) {
+                if (k & 1) mul_into(res, y, tmp, t), swap(res, tmp);
+                if (k > 1) mul_into(y, y, tmp, t), swap(y, tmp);
+            }
+        });
+        double pooled = seconds([&] { pow(x, e, t); });
+        printf("pow mint  n=%4d threads=%2d spawn-per-mul %8.4fs pool "
+               "%8.4fs\n",
+               n, t, spawn, pooled);
+    }
+}
+
+int main(int argc, char **argv) {
+    int max_threads = argc > 1 ? atoi(argv[1]) : 32;
+    int naive_max   = argc > 2 ? atoi(argv[2]) : 1024;
+    printf("hardware_concurrency=%u\n", thread::hardware_concurrency());
+
+    bench_blocked<double>("double", naive_max);
+    bench_blocked<mint>("mint", naive_max);
+
+    bench_threads<double>("double", 1024, max_threads);
+    bench_threads<mint>("mint", 1024, max_threads);
+    bench_pow(64, max_threads);
+    bench_pow(128, max_threads);
+}
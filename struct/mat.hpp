@@ -2,74 +2,229 @@
 
 #include "../prelude.hpp"
 
+#include "../util/thread_pool.hpp"
+#include "../wrapper/dbl.hpp"
+#include "../wrapper/modint.hpp"
+
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iostream>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace pcl {
+
+/// 行列の積でループを分割するブロックの大きさ
+constexpr int mat_block = 64;
+
+/**
+ * @brief 消去法で使う、成分の型ごとの性質。
+ * @details 一般の型は体 (modint など) とみなし、 0 でない成分ならどれでも枢
+ * 軸 (ピボット) にしてよいので、 weight() は 0 か 1 を返す。浮動小数点数
+ * (float, double, long double, dbl) では誤差を抑えるため、絶対値が最大の成
+ * 分を枢軸に選び (部分ピボット選択) 、絶対値が EPS 以下なら 0 とみなす。
+ */
+template <typename T, typename = void>
+struct elimination_traits {
+    constexpr static double eps = 0;
+
+    static double weight(T const &x) {
+        return x == T(0) ? 0 : 1;
+    }
+};
+
+/// float, double, long double
+template <typename T>
+struct elimination_traits<
+    T, typename std::enable_if<std::is_floating_point<T>::value>::type> {
+    constexpr static double eps = EPS;
+
+    static T weight(T x) {
+        return std::abs(x);
+    }
+};
+
+template <>
+struct elimination_traits<dbl> {
+    constexpr static double eps = EPS;
+
+    static double weight(dbl const &x) {
+        return std::abs(static_cast<double>(x));
+    }
+};
+
+/**
+ * @brief h x w の行列 a (行優先) を、ガウスの消去法で in-place に行階段形に
+ * する。
+ * @param[in] lim 先頭 lim 列からだけ枢軸を選ぶ。拡大係数行列で使う。
+ * @param[in] reduce true なら枢軸を 1 にして、枢軸の列の他の成分も全て消す
+ * (被約行階段形) 。 false なら枢軸より下だけを消す。
+ * @param[out] det 枢軸の積に行の入れ替えの符号を掛けたもの。 lim == h で枢
+ * 軸が h 個あれば、先頭 h 列の行列式になる。
+ * @return 枢軸のある列の番号のリスト。長さが階数になる。計算量は O(h w lim)
+ * 。
+ */
+template <typename T>
+std::vector<int> row_echelon_impl(std::vector<T> &a, int h, int w, int lim,
+                                  bool reduce, T &det) {
+    using traits = elimination_traits<T>;
+    std::vector<int> piv;
+    det = T(1);
+    for (int c = 0, r = 0; c < lim && r < h; c++) {
+        int p = r;
+        for (int i = r + 1; i < h; i++) {
+            if (traits::weight(a[i * w + c]) > traits::weight(a[p * w + c])) {
+                p = i;
+            }
+        }
+        if (traits::weight(a[p * w + c]) <= traits::eps) continue;
+        if (p != r) {
+            std::swap_ranges(a.begin() + p * w, a.begin() + (p + 1) * w,
+                             a.begin() + r * w);
+            det = T(0) - det;
+        }
+
+        T *pr = a.data() + r * w;
+        det *= pr[c];
+        T inv = T(1) / pr[c];
+        if (reduce) {
+            for (int j = c; j < w; j++) pr[j] *= inv;
+        }
+        for (int i = reduce ? 0 : r + 1; i < h; i++) {
+            if (i == r) continue;
+            T *pi = a.data() + i * w;
+            T f   = reduce ? pi[c] : pi[c] * inv;
+            if (traits::weight(f) == 0) continue;
+            for (int j = c; j < w; j++) pi[j] -= f * pr[j];
+        }
+        piv.push_back(c);
+        r++;
+    }
+    return piv;
+}
+
+/**
+ * @brief 整数の h x w の行列 a (行優先) を、 Bareiss のアルゴリズムで
+ * in-place に行階段形にする。
+ * @return (階数, 行列式) 。行列式は正方行列のときだけ意味を持つ。
+ * @details 消去した後の各成分は元の行列の小行列式になり、一つ前の枢軸での
+ * 除算は必ず割り切れる。よって分数を使わずに正確に計算できる。途中の積は
+ * __int128 で計算するので、全ての小行列式が T に収まれば溢れない。
+ */
+template <typename T>
+std::pair<int, T> bareiss_impl(std::vector<T> &a, int h, int w) {
+    T prev = 1, sign = 1;
+    int r  = 0;
+    for (int c = 0; c < w && r < h; c++) {
+        int p = r;
+        while (p < h && a[p * w + c] == 0) p++;
+        if (p == h) continue;
+        if (p != r) {
+            std::swap_ranges(a.begin() + p * w, a.begin() + (p + 1) * w,
+                             a.begin() + r * w);
+            sign = -sign;
+        }
+
+        T const *pr = a.data() + r * w;
+        for (int i = r + 1; i < h; i++) {
+            T *pi = a.data() + i * w;
+            for (int j = c + 1; j < w; j++) {
+                pi[j] = (static_cast<__int128>(pi[j]) * pr[c] -
+                         static_cast<__int128>(pi[c]) * pr[j]) /
+                        prev;
+            }
+            pi[c] = 0;
+        }
+        prev = pr[c];
+        r++;
+    }
+    return {r, r == h && h == w ? sign * prev : T(0)};
+}
+
+/**
+ * @brief h x w の行列
+ * @details 要素は一つの連続した領域に行優先 (row-major) で並べて持つ。 (i, j)
+ * 成分は v_[i * w + j] 。
+ */
 template <typename T>
 class mat {
   private:
     int h_, w_;
-    std::vector<std::vector<T>> v_;
+    std::vector<T> v_;
 
     template <typename U>
     friend bool operator==(mat<U> const &a, mat<U> const &b);
 
   public:
-    mat(std::vector<std::vector<T>> &&init)
+    mat(std::vector<std::vector<T>> const &init)
         : h_(init.size())
-        , w_(init[0].size())
-        , v_(std::move(init)) {
+        , w_(init.empty() ? 0 : init[0].size()) {
         // the dimension of matrix must be positive.
-        // (maybe before approaching this assertion exception is already
-        // triggered when attempted to create vector of negative length)
         assert(h_ > 0);
         assert(w_ > 0);
 
+        v_.reserve(h_ * w_);
         for (int i = 0; i < h_; i++) {
             // matrix initializer has incompatible size: the number of cols
             // differs row by row.
-            assert(w_ == static_cast<int>(v_[i].size()));
+            assert(w_ == static_cast<int>(init[i].size()));
+            v_.insert(v_.end(), init[i].begin(), init[i].end());
         }
     }
 
-    mat(std::vector<std::vector<T>> const &init)
-        : mat(std::vector<std::vector<T>>(init)) {
-    }
-
     mat(int h, int w)
-        : mat(std::vector<std::vector<T>>(h, std::vector<T>(w))) {
+        : h_(h)
+        , w_(w)
+        , v_(h * w) {
+        assert(h_ > 0);
+        assert(w_ > 0);
     }
 
-    mat(std::initializer_list<std::initializer_list<T>> &&init) {
-        for (auto row : std::move(init)) {
-            v_.emplace_back(row);
-        }
-        h_ = v_.size();
-
-        // matrix initializer must have positive number of rows.
+    mat(std::initializer_list<std::initializer_list<T>> init)
+        : h_(init.size())
+        , w_(init.size() == 0 ? 0 : init.begin()->size()) {
+        // matrix initializer must have positive number of rows and cols.
         assert(h_ > 0);
-
-        w_ = v_[0].size();
         assert(w_ > 0);
 
-        for (int i = 0; i < h_; i++) {
+        v_.reserve(h_ * w_);
+        for (auto const &row : init) {
             // matrix initializer has incompatible size: the number of cols
             // differs row by row.
-            assert(w_ == static_cast<int>(v_[i].size()));
+            assert(w_ == static_cast<int>(row.size()));
+            v_.insert(v_.end(), row.begin(), row.end());
         }
     }
 
     mat(mat const &o) = default;
 
+    mat(mat &&o) = default;
+
+    /// n 次の単位行列を作る。
+    static mat identity(int n) {
+        mat res(n, n);
+        for (int i = 0; i < n; i++) res.v_[i * n + i] = T(1);
+        return res;
+    }
+
+    /// 大きさを変える。重なる部分の成分は保たれ、増えた部分は T{} になる。
     void resize(int h, int w) {
         assert(h > 0);
         assert(w > 0);
+        if (w != w_) {
+            std::vector<T> v(h * w);
+            for (int i = 0; i < std::min(h, h_); i++) {
+                std::copy(v_.begin() + i * w_,
+                          v_.begin() + i * w_ + std::min(w, w_),
+                          v.begin() + i * w);
+            }
+            v_.swap(v);
+        } else {
+            v_.resize(h * w);
+        }
         h_ = h, w_ = w;
-
-        v_.resize(h_);
-        for (int i = 0; i < h_; i++) v_.resize(w_);
     }
 
     int height() const {
@@ -82,13 +237,31 @@ class mat {
     inline T const &at(int i, int j) const {
         assert(in_range(0, i, h_));
         assert(in_range(0, j, w_));
-        return v_[i][j];
+        return v_[i * w_ + j];
     }
 
     inline T &at(int i, int j) {
         assert(in_range(0, i, h_));
         assert(in_range(0, j, w_));
-        return v_[i][j];
+        return v_[i * w_ + j];
+    }
+
+    /// i 行目の先頭へのポインタ。範囲の検査はしない。
+    inline T const *operator[](int i) const {
+        return v_.data() + i * w_;
+    }
+
+    inline T *operator[](int i) {
+        return v_.data() + i * w_;
+    }
+
+    /// 全成分 (行優先) の先頭へのポインタ
+    T const *data() const {
+        return v_.data();
+    }
+
+    T *data() {
+        return v_.data();
     }
 
     mat &operator=(mat const &o) {
@@ -105,8 +278,7 @@ class mat {
 
     mat operator-() const {
         mat res = *this;
-        for (int i = 0; i < h_; i++)
-            for (int j = 0; j < w_; j++) res[i][j] = -res[i][j];
+        for (auto &x : res.v_) x = -x;
         return res;
     }
 
@@ -115,8 +287,8 @@ class mat {
         assert(h_ == o.h_);
         assert(w_ == o.w_);
 
-        for (int i = 0; i < h_; i++)
-            for (int j = 0; j < w_; j++) v_[i][j] += o.v_[i][j];
+        for (int i = 0; i < h_ * w_; i++) v_[i] += o.v_[i];
+        return *this;
     }
 
     mat &operator-=(mat const &o) {
@@ -124,8 +296,8 @@ class mat {
         assert(h_ == o.h_);
         assert(w_ == o.w_);
 
-        for (int i = 0; i < h_; i++)
-            for (int j = 0; j < w_; j++) v_[i][j] -= o.v_[i][j];
+        for (int i = 0; i < h_ * w_; i++) v_[i] -= o.v_[i];
+        return *this;
     }
 
     mat removed(int r, int l) const {
@@ -136,29 +308,99 @@ class mat {
         mat res(h_ - 1, w_ - 1);
         for (int i = 0; i < h_; i++) {
             if (i == r) continue;
-            for (int j = 0; j < h_; j++) {
+            for (int j = 0; j < w_; j++) {
                 if (j == l) continue;
                 int ni = i > r ? i - 1 : i;
                 int nj = j > l ? j - 1 : j;
 
-                res.v_[ni][nj] = v_[i][j];
+                res.at(ni, nj) = at(i, j);
             }
         }
         return res;
     }
 
+    /**
+     * @brief 行列式
+     * @details 整数型なら Bareiss のアルゴリズムで正確に、それ以外の型 (浮動
+     * 小数点数や modint など) ならガウスの消去法で求める。どちらも O(n^3) 。
+     */
     T det() const {
         // if non-square matrix, cannot calculate determinant.
         assert(h_ == w_);
 
-        if (h_ == 1) return v_[h_][w_];
-        if (h_ == 2) return v_[0][0] * v_[1][1] - v_[0][1] * v_[1][0];
+        std::vector<T> a = v_;
+        return det_impl(a, std::is_integral<T>());
+    }
+
+    /// 階数。 det() と同じく、整数型なら Bareiss のアルゴリズムを使う。
+    int rank() const {
+        std::vector<T> a = v_;
+        return rank_impl(a, std::is_integral<T>());
+    }
+
+    /**
+     * @brief 逆行列
+     * @details 正則でなければならない。正則かどうか分からなければ
+     * inverse_into() を使う。
+     */
+    mat inverse() const {
+        mat res(h_, w_);
+        bool ok = inverse_into(*this, res);
+        // the matrix is singular.
+        assert(ok);
+        return res;
+    }
+
+    /**
+     * @brief 連立一次方程式 A x = b の解の一つ
+     * @return 解の一つ (自由変数は 0 にしたもの) 。解がなければ空。
+     * @details 拡大係数行列 (A | b) を被約行階段形にする。計算量は
+     * O(h w min(h, w)) 。 T は体 (浮動小数点数や modint など) でなければな
+     * らない。
+     */
+    std::vector<T> solve(std::vector<T> const &b) const {
+        static_assert(!std::is_integral<T>::value,
+                      "solve() needs a field; use modint or double");
+        assert(static_cast<int>(b.size()) == h_);
+
+        int w = w_ + 1;
+        std::vector<T> a(h_ * w);
+        for (int i = 0; i < h_; i++) {
+            std::copy(v_.begin() + i * w_, v_.begin() + (i + 1) * w_,
+                      a.begin() + i * w);
+            a[i * w + w_] = b[i];
+        }
+        T d;
+        auto piv     = row_echelon_impl(a, h_, w, w_, true, d);
+        int rank     = piv.size();
+        using traits = elimination_traits<T>;
+        for (int i = rank; i < h_; i++) {
+            if (traits::weight(a[i * w + w_]) > traits::eps) return {};
+        }
+
+        std::vector<T> x(w_);
+        for (int i = 0; i < rank; i++) x[piv[i]] = a[i * w + w_];
+        return x;
+    }
 
-        T v_det{};
-        for (int i = 0; i < h_; i++)
-            v_det += removed(i, 0).det() * v_[i][0] * (i % 2 == 0 ? 1 : -1);
+  private:
+    T det_impl(std::vector<T> &a, std::true_type) const {
+        return bareiss_impl(a, h_, w_).second;
+    }
+
+    T det_impl(std::vector<T> &a, std::false_type) const {
+        T d;
+        auto piv = row_echelon_impl(a, h_, w_, w_, false, d);
+        return static_cast<int>(piv.size()) == h_ ? d : T(0);
+    }
 
-        return v_det;
+    int rank_impl(std::vector<T> &a, std::true_type) const {
+        return bareiss_impl(a, h_, w_).first;
+    }
+
+    int rank_impl(std::vector<T> &a, std::false_type) const {
+        T d;
+        return row_echelon_impl(a, h_, w_, w_, false, d).size();
     }
 };
 
@@ -167,10 +409,7 @@ bool operator==(mat<T> const &a, mat<T> const &b) {
     int h = a.height(), w = a.width();
     assert(h == b.height());
     assert(w == b.width());
-    for (int i = 0; i < h; i++)
-        for (int j = 0; j < w; j++)
-            if (a.at(i, j) != b.at(i, j)) return false;
-    return true;
+    return std::equal(a.data(), a.data() + h * w, b.data());
 }
 
 template <typename T>
@@ -188,22 +427,240 @@ mat<T> operator-(mat<T> a, mat<T> const &b) {
     return (a -= b);
 }
 
+/**
+ * @brief 行 [0, n) を pool のスレッドで分担して f(begin, end) を呼ぶ。
+ * @details 行を mat_block 行ずつのタイルに分け、連続するタイルをまとめて各
+ * スレッドに割り振る。タイルがスレッドより少なければ、余ったスレッドは何も
+ * しない。スレッドが一つかタイルが一つしかなければ、呼び出したスレッドで
+ * f(0, n) を呼ぶだけになる。
+ */
+template <typename F>
+void parallel_rows_impl(int n, thread_pool &pool, F const &f) {
+    int tiles   = (n + mat_block - 1) / mat_block;
+    int threads = std::max(1, std::min(pool.size(), tiles));
+    if (threads == 1) {
+        f(0, n);
+        return;
+    }
+    auto row = [&](int t) {
+        return std::min(n, static_cast<int>(1ll * tiles * t / threads) *
+                               mat_block);
+    };
+    pool.run([&](int t) {
+        if (t < threads) f(row(t), row(t + 1));
+    });
+}
+
+/**
+ * @brief mul_into() の作業領域
+ * @details 繰り返し掛け算するとき (pow() など) に呼び出し元で一つ持って使い
+ * 回すと、掛け算ごとに確保し直さずに済む。一般の型の積では使わない。
+ */
+struct mat_mul_buffer {
+    /// modint の積での、 b の成分の値
+    std::vector<ull> b;
+
+    /// modint の積で剰余をとる前の、 res の全ての行の分の足し込み先
+    std::vector<ull> acc;
+};
+
+/**
+ * @brief res = a * b を計算する。
+ * @param[in] pool 使うスレッドの集まり。出力の行をタイルごとに分担する。
+ * @details res の領域は使い回されるので、繰り返し掛け算するときに毎回確保し
+ * 直さずに済む。 res は a, b と別のものでなければならない。
+ * i, k, j の順にループを回すので、最内ループは b と res の行を連続に読み書
+ * きし、算術型ならベクトル化される。さらに各ループを mat_block 個ずつのブ
+ * ロックに分けて、ブロックの中の成分がキャッシュに載っている間に使い切る。
+ * 各成分への足し込みの順序はスレッドの数によらないので、浮動小数点数でも
+ * 結果はスレッドの数によらずビット単位で一致する。
+ */
 template <typename T>
-mat<T> operator*(mat<T> const &a, mat<T> const &b) {
+void mul_into(mat<T> const &a, mat<T> const &b, mat<T> &res,
+              thread_pool &pool, mat_mul_buffer &) {
     int n = a.height(), m = a.width(), l = b.width();
 
     // assert size restriction: otherwise they're incompatible for *.
     assert(m == b.height());
+    assert(&res != &a && &res != &b);
+
+    res.resize(n, l);
+    parallel_rows_impl(n, pool, [&](int i_begin, int i_end) {
+        std::fill(res[i_begin], res[i_begin] + (i_end - i_begin) * l, T{});
+        for (int i0 = i_begin; i0 < i_end; i0 += mat_block) {
+            int i1 = std::min(i_end, i0 + mat_block);
+            for (int k0 = 0; k0 < m; k0 += mat_block) {
+                int k1 = std::min(m, k0 + mat_block);
+                for (int j0 = 0; j0 < l; j0 += mat_block) {
+                    int j1 = std::min(l, j0 + mat_block);
+                    for (int i = i0; i < i1; i++) {
+                        T *r = res[i];
+                        for (int k = k0; k < k1; k++) {
+                            T const aik = a[i][k], *bk = b[k];
+                            for (int j = j0; j < j1; j++) {
+                                r[j] += aik * bk[j];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
 
-    mat<T> res(n, l);
-    for (int i = 0; i < n; i++)
-        for (int j = 0; j < l; j++)
-            for (int k = 0; k < m; k++)
-                res.at(i, j) += a.at(i, k) * b.at(k, j);
+/**
+ * @brief modint の行列の積 res = a * b
+ * @details 成分の値 (MOD 未満) を ull のまま掛けて足し、溢れる前に一回だけ
+ * 剰余をとる (遅延剰余) 。 k 方向のブロックの大きさを、 MOD 未満の値に積を
+ * ブロック分足しても 2^64 未満に収まる数にしておき、ブロックごとに剰余をと
+ * る。 MOD は modint の乗算と同じく 2^32 以下でなければならない。 b の値と
+ * 足し込み先は buf に置くので、 buf を使い回せば領域を確保し直さない。
+ */
+template <ll MOD>
+void mul_into(mat<modint<MOD>> const &a, mat<modint<MOD>> const &b,
+              mat<modint<MOD>> &res, thread_pool &pool,
+              mat_mul_buffer &buf) {
+    int n = a.height(), m = a.width(), l = b.width();
 
+    // assert size restriction: otherwise they're incompatible for *.
+    assert(m == b.height());
+    assert(&res != &a && &res != &b);
+
+    // (MOD - 1)^2 が ull に収まらないと、以下の room が正しく求まらない。
+    static_assert(MOD <= (1ll << 32), "MOD must be at most 2^32");
+
+    // 剰余をとらずに足せる積の個数
+    constexpr ull mx   = static_cast<ull>(MOD - 1) * (MOD - 1);
+    constexpr ull room = mx == 0 ? mat_block : (~0ull - (MOD - 1)) / mx;
+    int const kb       = std::min<ull>(room, mat_block);
+
+    buf.b.resize(m * l);
+    buf.acc.resize(n * l);
+    ull *const bv = buf.b.data();
+    for (int k = 0; k < m * l; k++) bv[k] = static_cast<ll>(b.data()[k]);
+    res.resize(n, l);
+    parallel_rows_impl(n, pool, [&](int i_begin, int i_end) {
+        // 担当する行の分の足し込み先
+        ull *const acc = buf.acc.data() + i_begin * l;
+        std::fill(acc, acc + (i_end - i_begin) * l, 0ull);
+        for (int i0 = i_begin; i0 < i_end; i0 += mat_block) {
+            int i1 = std::min(i_end, i0 + mat_block);
+            for (int k0 = 0; k0 < m; k0 += kb) {
+                int k1 = std::min(m, k0 + kb);
+                for (int j0 = 0; j0 < l; j0 += mat_block) {
+                    int j1 = std::min(l, j0 + mat_block);
+                    for (int i = i0; i < i1; i++) {
+                        ull *r = acc + (i - i_begin) * l;
+                        for (int k = k0; k < k1; k++) {
+                            ull aik       = static_cast<ll>(a[i][k]);
+                            ull const *bk = bv + k * l;
+                            for (int j = j0; j < j1; j++) {
+                                r[j] += aik * bk[j];
+                            }
+                        }
+                        for (int j = j0; j < j1; j++) r[j] %= MOD;
+                    }
+                }
+            }
+        }
+        std::copy(acc, acc + (i_end - i_begin) * l, res[i_begin]);
+    });
+}
+
+/// res = a * b を pool のスレッドで計算する。作業領域は呼び出しごとに作る。
+template <typename T>
+void mul_into(mat<T> const &a, mat<T> const &b, mat<T> &res,
+              thread_pool &pool) {
+    mat_mul_buffer buf;
+    mul_into(a, b, res, pool, buf);
+}
+
+/**
+ * @brief res = a * b を threads 個のスレッドで計算する。
+ * @details 一回だけ掛けるとき用。スレッドは呼び出しごとに作るので、何度も掛
+ * けるなら thread_pool を作って渡す方がよい。
+ */
+template <typename T>
+void mul_into(mat<T> const &a, mat<T> const &b, mat<T> &res,
+              int threads = 1) {
+    thread_pool pool(threads);
+    mul_into(a, b, res, pool);
+}
+
+/**
+ * @brief 正方行列 a の逆行列を res に求める。
+ * @return a が正則なら true 。正則でなければ false で、 res の中身は不定。
+ * @details 拡大係数行列 (A | I) を被約行階段形にすると (I | A^{-1}) になる。
+ * 計算量は O(n^3) 。 T は体 (浮動小数点数や modint など) でなければならな
+ * い。
+ */
+template <typename T>
+bool inverse_into(mat<T> const &a, mat<T> &res) {
+    static_assert(!std::is_integral<T>::value,
+                  "inverse needs a field; use modint or double");
+    // only square matrices can be inverted.
+    assert(a.height() == a.width());
+
+    int n = a.height(), w = 2 * n;
+    std::vector<T> b(n * w);
+    for (int i = 0; i < n; i++) {
+        std::copy(a[i], a[i] + n, b.begin() + i * w);
+        b[i * w + n + i] = T(1);
+    }
+    T d;
+    if (static_cast<int>(row_echelon_impl(b, n, w, n, true, d).size()) < n) {
+        return false;
+    }
+
+    res.resize(n, n);
+    for (int i = 0; i < n; i++) {
+        std::copy(b.begin() + i * w + n, b.begin() + (i + 1) * w, res[i]);
+    }
+    return true;
+}
+
+template <typename T>
+mat<T> operator*(mat<T> const &a, mat<T> const &b) {
+    mat<T> res(a.height(), b.width());
+    mul_into(a, b, res);
     return res;
 }
 
+/**
+ * @brief 正方行列 x の n 乗を繰り返し二乗法で求める。
+ * @param[in] pool 各掛け算で使うスレッドの集まり (mul_into() を参照) 。
+ * @details 掛け算の結果は作業用の行列 tmp に書き込んでから swap し、
+ * mul_into() の作業領域 buf も全ての掛け算で使い回すので、ループ中に領域を
+ * 確保し直すことはない。スレッドも全ての掛け算で同じものを使い回す。
+ */
+template <typename T>
+mat<T> pow(mat<T> x, ull n, thread_pool &pool) {
+    // only square matrices can be powered.
+    assert(x.height() == x.width());
+
+    mat<T> res = mat<T>::identity(x.height()), tmp(x.height(), x.width());
+    mat_mul_buffer buf;
+    while (n > 0) {
+        if (n & 1) {
+            mul_into(res, x, tmp, pool, buf);
+            std::swap(res, tmp);
+        }
+        n >>= 1;
+        if (n > 0) {
+            mul_into(x, x, tmp, pool, buf);
+            std::swap(x, tmp);
+        }
+    }
+    return res;
+}
+
+/// threads 個のスレッドで x の n 乗を求める。スレッドは一度だけ作る。
+template <typename T>
+mat<T> pow(mat<T> x, ull n, int threads = 1) {
+    thread_pool pool(threads);
+    return pow(std::move(x), n, pool);
+}
+
 template <typename T>
 std::ostream &operator<<(std::ostream &os, mat<T> const &m) {
     os << "mat { ";
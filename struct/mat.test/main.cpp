@@ -3,12 +3,37 @@
 #include "prelude.hpp"
 
 #include "struct/mat.hpp"
+#include "wrapper/modint.hpp"
 
 #include <bits/stdc++.h>
 
 using namespace std;
 using namespace pcl;
 
+/// 定義通りの O(nml) の積
+template <typename T>
+mat<T> mul_naive(mat<T> const &a, mat<T> const &b) {
+    mat<T> res(a.height(), b.width());
+    for (int i = 0; i < a.height(); i++)
+        for (int j = 0; j < b.width(); j++)
+            for (int k = 0; k < a.width(); k++)
+                res.at(i, j) += a.at(i, k) * b.at(k, j);
+    return res;
+}
+
+/// ブロックの大きさで割り切れない大きさでも、ブロック化した積が定義通りの積
+/// と一致するか。
+template <typename T>
+bool check_blocked(int n, int m, int l, ll range) {
+    mt19937_64 rng(n * m * l);
+    mat<T> a(n, m), b(m, l);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < m; j++) a.at(i, j) = T(rng() % range);
+    for (int i = 0; i < m; i++)
+        for (int j = 0; j < l; j++) b.at(i, j) = T(rng() % range);
+    return a * b == mul_naive(a, b);
+}
+
 int main() {
     int n, m, l;
     cin >> n >> m >> l;
@@ -27,4 +52,100 @@ int main() {
 
     assert(n == l);
     cout << C.det() << endl;
+
+    ull k;
+    cin >> k;
+    mat<mint> F = {{1, 1}, {1, 0}};
+    cout << pow(F, k).at(0, 1) << endl;
+
+    cout << check_blocked<ll>(70, 131, 65, 1e6)
+         << check_blocked<mint>(150, 100, 3, P7)
+         << check_blocked<modint<998244353>>(1, 200, 129, P7)
+         << check_blocked<modint<5>>(65, 70, 64, 5) << endl;
+
+    // += と -= は *this を返す。
+    mat<ll> D = {{1, 2}, {3, 4}};
+    (D += D) -= mat<ll>{{1, 1}, {1, 1}};
+    cout << D << endl;
+
+    // 大きさを変えても重なる部分は保たれる。
+    D.resize(3, 1);
+    cout << D << endl;
+
+    // 消去法による行列式・階数・逆行列・連立方程式
+    mat<ll> S = {{2, 4, 6}, {1, 3, 5}, {7, 8, 10}};
+    mat<mint> Sm(3, 3);
+    mat<double> Sd(3, 3);
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++) Sm.at(i, j) = Sd.at(i, j) = S.at(i, j);
+    cout << S.det() << ' ' << Sm.det() << ' ' << Sd.det() << endl;
+    cout << (Sm * Sm.inverse() == mat<mint>::identity(3)) << endl;
+    cout << Sd.inverse() << endl;
+    cout << Sm.solve({4, 3, 9}) << ' ' << Sd.solve({4, 3, 9}) << endl;
+
+    // 階数落ちの行列
+    mat<ll> T = {{1, 2, 3, 4}, {2, 4, 6, 8}, {1, 0, 1, 0}};
+    mat<mint> Tm(3, 4), U(3, 3);
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 4; j++) Tm.at(i, j) = T.at(i, j);
+    cout << T.rank() << ' ' << Tm.rank() << ' ' << mat<ll>(3, 3).rank()
+         << endl;
+    cout << Tm.solve({1, 2, 3}) << ' ' << Tm.solve({1, 3, 3}).size() << endl;
+    cout << inverse_into(mat<mint>{{1, 2}, {2, 4}}, U) << ' '
+         << mat<ll>{{5}}.det() << endl;
+
+    // float や long double でも部分ピボット選択をし、 EPS 以下を 0 とみなす。
+    auto xf = mat<float>{{1e-10f, 1}, {1, 1}}.solve({1, 2});
+    mat<long double> Tl = {{1, 2}, {2, 4 + 1e-12L}};
+    cout << (abs(xf[0] - 1) < 1e-5 && abs(xf[1] - 1) < 1e-5) << ' '
+         << Tl.rank() << endl;
+
+    // 複数スレッドでの積や冪は、一スレッドのものとビット単位で一致する。
+    {
+        int const N = 200;
+        mat<double> P(N, N), Q(N, N), R1(N, N), R4(N, N);
+        mat<mint> Pm(N, N);
+        mt19937_64 rng(N);
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < N; j++) {
+                P.at(i, j)  = uniform_real_distribution<>(-1, 1)(rng);
+                Q.at(i, j)  = uniform_real_distribution<>(-1, 1)(rng);
+                Pm.at(i, j) = rng() % P7;
+            }
+        }
+        mul_into(P, Q, R1);
+        mul_into(P, Q, R4, 4);
+        bool same = memcmp(R1.data(), R4.data(), sizeof(double) * N * N) == 0;
+        cout << same << (pow(Pm, 1000000007ll, 3) == pow(Pm, 1000000007ll));
+
+        // 同じ thread_pool を何度使っても結果は変わらない。
+        thread_pool pool(4);
+        mat<double> R5(N, N);
+        mul_into(P, Q, R5, pool);
+        auto Pp = pow(Pm, 998244353ll, pool);
+        mul_into(P, Q, R5, pool);
+        cout << (memcmp(R1.data(), R5.data(), sizeof(double) * N * N) == 0 &&
+                 Pp == pow(Pm, 998244353ll))
+             << endl;
+    }
+
+    // 作業領域は大きさの違う積で使い回してもよい。
+    {
+        mat<mint> A(3, 70), B(70, 5), C(2, 2), out(1, 1);
+        for (int i = 0; i < 3; i++)
+            for (int j = 0; j < 70; j++) A.at(i, j) = P7 - 1 - i * j;
+        for (int i = 0; i < 70; i++)
+            for (int j = 0; j < 5; j++) B.at(i, j) = i + 1000 * j;
+        C.at(0, 0) = 2, C.at(0, 1) = 3, C.at(1, 1) = 5;
+        thread_pool pool(2);
+        mat_mul_buffer buf;
+        bool ok = true;
+        mul_into(A, B, out, pool, buf);
+        ok &= out == A * B;
+        mul_into(C, C, out, pool, buf);
+        ok &= out == C * C;
+        mul_into(A, B, out, pool, buf);
+        ok &= out == A * B;
+        cout << ok << endl;
+    }
 }
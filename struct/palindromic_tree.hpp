@@ -0,0 +1,151 @@
+/**
+ * @file struct/palindromic_tree.hpp
+ * @brief 回文木 (eertree) - 文字列に含まれる回文をオンラインに管理する
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+namespace pcl {
+
+/**
+ * @brief 回文木 (eertree)
+ * @details 文字列に含まれる相異なる回文を、一つの回文につき一つのノードとし
+ * て持つ木。末尾に一文字追加するごとに新しくできる回文は高々一つなので、ノー
+ * ド数は |s| + 2 以下になる。ノード 0 は長さ -1 の (仮想的な) 根、ノード 1 は
+ * 長さ 0 の根。ノード v から文字 c の辺は回文 cvc を表す。
+ * 遷移は aho_corasick と同じく `ノード数 * alpha` の平坦な配列で持つ。文字は
+ * `base` から始まる連続した `alpha` 種類でなければならない。
+ * 一文字の追加は償却 O(1) (遷移表の確保を除く) 。
+ */
+template <int alpha = 26, char base = 'a'>
+class palindromic_tree {
+  private:
+    /// これまでに追加された文字列
+    std::string s_;
+
+    /// 遷移表。 next_[v * alpha + c] は v の両端に c を付けた回文のノード
+    /// (なければ -1) 。
+    std::vector<int> next_;
+
+    /// suffix link: 回文 v の真の接尾辞である最長の回文のノード。
+    std::vector<int> link_;
+
+    /// 回文 v の長さ
+    std::vector<int> len_;
+
+    /// 回文 v が「その位置で終わる最長の回文」になった回数
+    std::vector<ll> cnt_;
+
+    /// 現在の文字列の最長の接尾辞回文
+    int last_;
+
+    /// 文字を遷移表の添字に変換する。
+    static int index(char c) {
+        int i = static_cast<unsigned char>(c) -
+                static_cast<unsigned char>(base);
+        assert(in_range(0, i, alpha));
+        return i;
+    }
+
+    /// ノードを作る。
+    int new_node(int len, int link) {
+        next_.resize(next_.size() + alpha, -1);
+        len_.push_back(len);
+        link_.push_back(link);
+        cnt_.push_back(0);
+        return len_.size() - 1;
+    }
+
+    /// v から suffix link を辿り、 s_[i] を両端に付けられる最初の回文を探す。
+    int find(int v, int i) const {
+        while (true) {
+            int j = i - 1 - len_[v];
+            if (j >= 0 && s_[j] == s_[i]) return v;
+            v = link_[v];
+        }
+    }
+
+  public:
+    /// 空文字列の回文木を作る。
+    palindromic_tree()
+        : last_(1) {
+        new_node(-1, 0);
+        new_node(0, 0);
+    }
+
+    /// 文字列 s の回文木を作る。
+    palindromic_tree(std::string const &s)
+        : palindromic_tree() {
+        for (char c : s) add(c);
+    }
+
+    /**
+     * @brief 末尾に文字を追加する。
+     * @return 新しい回文が現れたら true
+     */
+    bool add(char ch) {
+        int i = s_.size();
+        int c = index(ch);
+        s_.push_back(ch);
+
+        int v = find(last_, i);
+        if (next_[v * alpha + c] != -1) {
+            last_ = next_[v * alpha + c];
+            cnt_[last_]++;
+            return false;
+        }
+
+        // 長さ 1 の回文の suffix link は空文字列へ張る。
+        int link = len_[v] == -1 ? 1 : next_[find(link_[v], i) * alpha + c];
+        int w    = new_node(len_[v] + 2, link);
+        next_[v * alpha + c] = w;
+        cnt_[w]++;
+        last_ = w;
+        return true;
+    }
+
+    /// 相異なる (空でない) 回文の個数
+    int size() const {
+        return len_.size() - 2;
+    }
+
+    /// ノード数 (二つの根を含む)
+    int count_nodes() const {
+        return len_.size();
+    }
+
+    /// 回文 v の長さ
+    int length(int v) const {
+        return len_[v];
+    }
+
+    /// 回文 v の suffix link
+    int link(int v) const {
+        return link_[v];
+    }
+
+    /// 現在の文字列の最長の接尾辞回文のノード
+    int longest_suffix() const {
+        return last_;
+    }
+
+    /**
+     * @brief 各回文の出現回数を求める。
+     * @return res[v] は回文 v の、これまでの文字列における出現回数。
+     * @details ある位置で終わる回文は、そこで終わる最長の回文から suffix link
+     * を辿ったものに等しい。 link_[v] < v なので、逆順に足し込めばよい。計算
+     * 量は O(ノード数) 。
+     */
+    std::vector<ll> occurrences() const {
+        std::vector<ll> res = cnt_;
+        for (int v = count_nodes() - 1; v >= 2; v--) res[link_[v]] += res[v];
+        return res;
+    }
+};
+
+} // namespace pcl
@@ -0,0 +1,26 @@
+#include "prelude.hpp"
+
+#include "struct/palindromic_tree.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+int main() {
+    string s;
+    cin >> s;
+
+    palindromic_tree<> pt;
+    for (char c : s) cout << pt.add(c);
+    cout << endl;
+
+    cout << pt.size() << endl;
+
+    auto occ = pt.occurrences();
+    ll total = 0;
+    for (int v = 2; v < pt.count_nodes(); v++) total += occ[v];
+    cout << total << endl;
+
+    cout << pt.length(pt.longest_suffix()) << endl;
+}
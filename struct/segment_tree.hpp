@@ -44,8 +44,8 @@ class segment_tree {
         : segment_tree(std::vector<value_type>(size_, init)) {
     }
 
-    void update(ll i, ll x) {
-        assert(0 <= i && i <= size_);
+    void update(ll i, value_type const &x) {
+        assert(0 <= i && i < size_);
         data_[i += n_] = x;
         while (i /= 2) data_[i] = Monoid::op(data_[i * 2], data_[i * 2 + 1]);
     }
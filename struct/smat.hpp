@@ -0,0 +1,244 @@
+/**
+ * @file struct/smat.hpp
+ * @brief 大きさがコンパイル時に決まる小さい行列
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include "../struct/vec.hpp"
+
+#include <array>
+#include <cassert>
+#include <iostream>
+
+namespace pcl {
+
+/**
+ * @brief R x C の行列 (大きさ固定)
+ * @details 成分は配列に行優先で持つので、ヒープを使わない。積や行列式、逆行
+ * 列は constexpr で、 2 x 2 の行列の冪による線形漸化式なども定数式の中で計
+ * 算できる。ループの回数は全てコンパイル時に決まるので、展開される。
+ * C++14 では std::array の非 const な operator[] が constexpr でないので、
+ * 成分は組み込みの配列で持つ。行列式と逆行列は 3 x 3 まで。
+ */
+template <typename T, int R, int C = R>
+class smat {
+    static_assert(R > 0 && C > 0, "the dimension of matrix must be positive");
+
+  private:
+    T v_[R * C];
+
+  public:
+    using value_type = T;
+
+    /// 零行列
+    constexpr smat()
+        : v_{} {
+    }
+
+    /// 成分を行優先で並べたもので初期化する。
+    constexpr smat(std::array<T, R * C> const &v)
+        : v_{} {
+        for (int i = 0; i < R * C; i++) v_[i] = v[i];
+    }
+
+    /// 単位行列
+    constexpr static smat identity() {
+        static_assert(R == C, "only square matrices have identity");
+        smat res;
+        for (int i = 0; i < R; i++) res.v_[i * C + i] = T(1);
+        return res;
+    }
+
+    /// 各行をベクトル (成分の型は T) で与えて作る。
+    static smat from_rows(std::array<vec<C, T>, R> const &rows) {
+        smat res;
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++) res.at(i, j) = rows[i][j];
+        return res;
+    }
+
+    constexpr static int height() {
+        return R;
+    }
+
+    constexpr static int width() {
+        return C;
+    }
+
+    constexpr T const &at(int i, int j) const {
+        // in_range() は constexpr でないので、直接比較する。
+        assert(0 <= i && i < R);
+        assert(0 <= j && j < C);
+        return v_[i * C + j];
+    }
+
+    constexpr T &at(int i, int j) {
+        assert(0 <= i && i < R);
+        assert(0 <= j && j < C);
+        return v_[i * C + j];
+    }
+
+    /// 転置行列
+    constexpr smat<T, C, R> transposed() const {
+        smat<T, C, R> res;
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++) res.at(j, i) = at(i, j);
+        return res;
+    }
+
+    constexpr smat &operator+=(smat const &o) {
+        for (int i = 0; i < R * C; i++) v_[i] += o.v_[i];
+        return *this;
+    }
+
+    constexpr smat &operator-=(smat const &o) {
+        for (int i = 0; i < R * C; i++) v_[i] -= o.v_[i];
+        return *this;
+    }
+
+    constexpr smat &operator*=(T const &c) {
+        for (int i = 0; i < R * C; i++) v_[i] *= c;
+        return *this;
+    }
+
+    /**
+     * @brief 行列式 (3 x 3 まで)
+     * @details 展開した式で直接計算する。
+     */
+    constexpr T det() const {
+        static_assert(R == C && R <= 3,
+                      "det() is only provided for square matrices up to 3x3");
+        if (R == 1) return at(0, 0);
+        if (R == 2) return at(0, 0) * at(1, 1) - at(0, 1) * at(1, 0);
+        return at(0, 0) * minor_impl(0, 0) - at(0, 1) * minor_impl(0, 1) +
+               at(0, 2) * minor_impl(0, 2);
+    }
+
+    /**
+     * @brief 逆行列 (3 x 3 まで)
+     * @details 余因子行列を行列式で割る。正則でなければならない。 T は体
+     * (浮動小数点数や modint など) でなければならない。
+     */
+    constexpr smat inverse() const {
+        static_assert(R == C && R <= 3,
+                      "inverse() is only provided for square matrices up to "
+                      "3x3");
+        T const d = det();
+        // the matrix is singular.
+        assert(!(d == T(0)));
+        smat res;
+        for (int i = 0; i < R; i++) {
+            for (int j = 0; j < C; j++) {
+                // (i, j) 成分は (j, i) 余因子を行列式で割ったもの
+                T c          = R == 1 ? T(1) : minor_impl(j, i);
+                res.at(i, j) = ((i + j) % 2 == 0 ? c : T(0) - c) / d;
+            }
+        }
+        return res;
+    }
+
+  private:
+    /// i 行 j 列を除いた小行列式 (2 x 2, 3 x 3 のときだけ使う)
+    constexpr T minor_impl(int i, int j) const {
+        if (R == 2) return at(1 - i, 1 - j);
+        // 残る行と列 (昇順)
+        int i0 = i == 0 ? 1 : 0, i1 = i == 2 ? 1 : 2;
+        int j0 = j == 0 ? 1 : 0, j1 = j == 2 ? 1 : 2;
+        return at(i0, j0) * at(i1, j1) - at(i0, j1) * at(i1, j0);
+    }
+};
+
+/*
+ * 演算
+ */
+
+template <typename T, int R, int C>
+constexpr bool operator==(smat<T, R, C> const &a, smat<T, R, C> const &b) {
+    for (int i = 0; i < R; i++)
+        for (int j = 0; j < C; j++)
+            if (!(a.at(i, j) == b.at(i, j))) return false;
+    return true;
+}
+
+template <typename T, int R, int C>
+constexpr bool operator!=(smat<T, R, C> const &a, smat<T, R, C> const &b) {
+    return !(a == b);
+}
+
+template <typename T, int R, int C>
+constexpr smat<T, R, C> operator+(smat<T, R, C> a, smat<T, R, C> const &b) {
+    return a += b;
+}
+
+template <typename T, int R, int C>
+constexpr smat<T, R, C> operator-(smat<T, R, C> a, smat<T, R, C> const &b) {
+    return a -= b;
+}
+
+template <typename T, int R, int C>
+constexpr smat<T, R, C> operator*(smat<T, R, C> a, T const &c) {
+    return a *= c;
+}
+
+/// 行列の積。各成分は長さ M の内積で、ループの回数は定数。
+template <typename T, int R, int M, int C>
+constexpr smat<T, R, C> operator*(smat<T, R, M> const &a,
+                                  smat<T, M, C> const &b) {
+    smat<T, R, C> res;
+    for (int i = 0; i < R; i++) {
+        for (int j = 0; j < C; j++) {
+            T sum = a.at(i, 0) * b.at(0, j);
+            for (int k = 1; k < M; k++) sum += a.at(i, k) * b.at(k, j);
+            res.at(i, j) = sum;
+        }
+    }
+    return res;
+}
+
+/// 行列とベクトルの積
+template <typename T, int R, int C>
+vec<R, T> operator*(smat<T, R, C> const &a, vec<C, T> const &x) {
+    vec<R, T> res;
+    for (int i = 0; i < R; i++)
+        for (int j = 0; j < C; j++) res[i] += a.at(i, j) * x[j];
+    return res;
+}
+
+/// 正方行列 x の n 乗 (繰り返し二乗法)
+template <typename T, int N>
+constexpr smat<T, N, N> pow(smat<T, N, N> x, ull n) {
+    smat<T, N, N> res = smat<T, N, N>::identity();
+    while (n > 0) {
+        if (n & 1) res = res * x;
+        n >>= 1;
+        if (n > 0) x = x * x;
+    }
+    return res;
+}
+
+template <typename T, int R, int C>
+std::ostream &operator<<(std::ostream &os, smat<T, R, C> const &m) {
+    os << "smat { ";
+    for (int i = 0; i < R; i++) {
+        if (i != 0) os << ", ";
+        os << "{ ";
+        for (int j = 0; j < C; j++) {
+            if (j != 0) os << ", ";
+            os << m.at(i, j);
+        }
+        os << " }";
+    }
+    os << " }";
+    return os;
+}
+
+template <typename T, int R, int C>
+std::istream &operator>>(std::istream &is, smat<T, R, C> &m) {
+    for (int i = 0; i < R; i++)
+        for (int j = 0; j < C; j++) is >> m.at(i, j);
+    return is;
+}
+
+} // namespace pcl
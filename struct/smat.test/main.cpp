@@ -0,0 +1,50 @@
+#include "prelude.hpp"
+
+#include "geom/point.hpp"
+#include "struct/smat.hpp"
+#include "wrapper/modint.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+/// コンパイル時に計算した Fibonacci 数
+constexpr mint fib(ull n) {
+    return pow(smat<mint, 2>({1, 1, 1, 0}), n).at(0, 1);
+}
+
+static_assert(fib(10) == 55, "");
+static_assert(smat<ll, 3>({2, 4, 6, 1, 3, 5, 7, 8, 10}).det() == 2, "");
+static_assert(smat<mint, 3>({2, 4, 6, 1, 3, 5, 7, 8, 10}).inverse() *
+                      smat<mint, 3>({2, 4, 6, 1, 3, 5, 7, 8, 10}) ==
+                  smat<mint, 3>::identity(),
+              "");
+
+int main() {
+    ull n;
+    cin >> n;
+    cout << fib(n) << endl;
+
+    smat<ll, 2, 3> A;
+    smat<ll, 3, 2> B;
+    cin >> A >> B;
+    cout << A * B << endl;
+    cout << A.transposed() << endl;
+    cout << (A * B).det() << ' ' << (B * A).det() << endl;
+
+    smat<double, 2> C({4, 7, 2, 6});
+    cout << C.inverse() << endl;
+    cout << smat<double, 1>({4}).inverse() << endl;
+
+    // ベクトルとの積 (回転)
+    auto rot = smat<dbl, 2>::from_rows({vec2(0, -1), vec2(1, 0)});
+    cout << rot * vec2(3, 4) << endl;
+
+    // 同一平面上にあるか
+    cout << on_plane(point<3>(0, 0, 0), point<3>(1, 0, 0), point<3>(0, 1, 0),
+                     point<3>(5, 7, 0))
+         << on_plane(point<3>(0, 0, 0), point<3>(1, 0, 0), point<3>(0, 1, 0),
+                     point<3>(5, 7, 1))
+         << endl;
+}
@@ -0,0 +1,80 @@
+/// ベンチマーク: 疎行列とベクトルの積 (SpMV) のスレッド数による速さ
+/// 使い方: ./a.out [最大スレッド数 (既定 32)] [行数 (既定 10^6)] [一行あたり
+/// の非零成分の数 (既定 10)] > bench_output.txt
+
+#include "prelude.hpp"
+
+#include "struct/sparse_mat.hpp"
+#include "util/thread_pool.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+/// f() を reps 回実行した中で最短の時間 (秒)
+template <typename F>
+double seconds(F const &f, int reps = 3) {
+    double best = 1e18;
+    for (int r = 0; r < reps; r++) {
+        auto start = chrono::steady_clock::now();
+        f();
+        chrono::duration<double> d = chrono::steady_clock::now() - start;
+        best = min(best, d.count());
+    }
+    return best;
+}
+
+/**
+ * n x n で非零成分が約 n * per_row 個の行列。行ごとの非零成分の数を 1 から
+ * 2 * per_row - 1 までばらつかせ、行で均等に分けると偏るようにする。
+ */
+sparse_mat<double> random_sparse(int n, int per_row, mt19937_64 &rng) {
+    vector<sparse_mat<double>::triplet> entries;
+    entries.reserve(static_cast<size_t>(n) * per_row);
+    for (int i = 0; i < n; i++) {
+        int k = 1 + rng() % (2 * per_row - 1);
+        for (int j = 0; j < k; j++) {
+            entries.emplace_back(i, rng() % n,
+                                 uniform_real_distribution<>(-1, 1)(rng));
+        }
+    }
+    return sparse_mat<double>(n, n, entries);
+}
+
+int main(int argc, char **argv) {
+    int max_threads = argc > 1 ? atoi(argv[1]) : 32;
+    int n           = argc > 2 ? atoi(argv[2]) : 1'000'000;
+    int per_row     = argc > 3 ? atoi(argv[3]) : 10;
+    printf("hardware_concurrency=%u\n", thread::hardware_concurrency());
+
+    mt19937_64 rng(n);
+    sparse_mat<double> a(0, 0);
+    double build = seconds([&] { a = random_sparse(n, per_row, rng); }, 1);
+    printf("build n=%d nnz=%d %8.4fs\n", n, a.nnz(), build);
+
+    vector<double> x(n), y(n);
+    for (auto &v : x) v = uniform_real_distribution<>(-1, 1)(rng);
+
+    // 一回の SpMV は短いので、 iters 回まとめて測る。
+    int const iters = 10;
+    double base     = 0;
+    for (int t = 1; t <= max_threads; t *= 2) {
+        thread_pool pool(t);
+        double s = seconds([&] {
+            for (int it = 0; it < iters; it++) mul_into(a, x, y, pool);
+        });
+        if (t == 1) base = s;
+        printf("spmv threads=%2d %8.4fs/iter speedup %5.2f\n", t, s / iters,
+               base / s);
+    }
+
+    // 反復法のように毎回スレッドを作る場合 (mul_into(..., int threads)) と
+    // 比べる。
+    for (int t = 1; t <= max_threads; t *= 2) {
+        double s = seconds([&] {
+            for (int it = 0; it < iters; it++) mul_into(a, x, y, t);
+        });
+        printf("spmv threads=%2d spawn-per-mul %8.4fs/iter\n", t, s / iters);
+    }
+}
@@ -0,0 +1,352 @@
+/**
+ * @file struct/sparse_mat.hpp
+ * @brief 疎行列 (CSR 形式) と反復法
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include "../util/thread_pool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace pcl {
+
+/**
+ * @brief CSR (Compressed Sparse Row) 形式の h x w 疎行列
+ * @details 非零成分を行の順に、行の中では列の昇順に並べ、列番号と値を別々の
+ * 配列に持つ。 i 行目の非零成分は [ptr[i], ptr[i + 1]) 番目にある。メモリは
+ * O(h + nnz) で、行列とベクトルの積 (SpMV) は各行の成分を連続に読むので
+ * キャッシュ効率がよい。構築後に成分を追加することはできない。
+ */
+template <typename T>
+class sparse_mat {
+  private:
+    int h_, w_;
+
+    /// i 行目の成分は [ptr_[i], ptr_[i + 1])
+    std::vector<int> ptr_;
+
+    std::vector<int> col_;
+    std::vector<T> val_;
+
+  public:
+    using value_type = T;
+
+    /// 成分 (行, 列, 値) の組
+    using triplet = std::tuple<int, int, T>;
+
+    /// h x w の零行列
+    sparse_mat(int h, int w)
+        : h_(h)
+        , w_(w)
+        , ptr_(h + 1) {
+        assert(h >= 0 && w >= 0);
+    }
+
+    /**
+     * @brief 成分の組から作る。
+     * @details 同じ位置の成分が複数あれば足し合わせる。順序は任意。行で計数
+     * ソートしてから各行の中を列でソートするので、計算量は
+     * O(h + nnz log(nnz / h)) 程度。
+     */
+    sparse_mat(int h, int w, std::vector<triplet> const &entries)
+        : sparse_mat(h, w) {
+        for (auto const &e : entries) {
+            assert(in_range(0, std::get<0>(e), h_));
+            assert(in_range(0, std::get<1>(e), w_));
+            ptr_[std::get<0>(e) + 1]++;
+        }
+        for (int i = 0; i < h_; i++) ptr_[i + 1] += ptr_[i];
+
+        std::vector<std::pair<int, T>> buf(entries.size());
+        std::vector<int> pos(ptr_.begin(), ptr_.end() - 1);
+        for (auto const &e : entries) {
+            buf[pos[std::get<0>(e)]++] = {std::get<1>(e), std::get<2>(e)};
+        }
+
+        col_.reserve(buf.size());
+        val_.reserve(buf.size());
+        for (int i = 0; i < h_; i++) {
+            auto first = buf.begin() + ptr_[i];
+            auto last  = buf.begin() + ptr_[i + 1];
+            std::sort(first, last, [](auto const &a, auto const &b) {
+                return a.first < b.first;
+            });
+            ptr_[i] = col_.size();
+            for (auto it = first; it != last; ++it) {
+                if (static_cast<int>(col_.size()) > ptr_[i] &&
+                    col_.back() == it->first) {
+                    val_.back() += it->second;
+                } else {
+                    col_.push_back(it->first);
+                    val_.push_back(it->second);
+                }
+            }
+        }
+        ptr_[h_] = col_.size();
+    }
+
+    int height() const {
+        return h_;
+    }
+
+    int width() const {
+        return w_;
+    }
+
+    /// 非零成分 (として持っている成分) の数
+    int nnz() const {
+        return col_.size();
+    }
+
+    /// 行の先頭の位置 (長さ h + 1)
+    std::vector<int> const &row_ptr() const {
+        return ptr_;
+    }
+
+    /// 各成分の列番号
+    std::vector<int> const &col_index() const {
+        return col_;
+    }
+
+    /// 各成分の値
+    std::vector<T> const &values() const {
+        return val_;
+    }
+
+    /// (i, j) 成分。行の中を二分探索する。
+    T at(int i, int j) const {
+        assert(in_range(0, i, h_));
+        assert(in_range(0, j, w_));
+        auto first = col_.begin() + ptr_[i];
+        auto last  = col_.begin() + ptr_[i + 1];
+        auto it    = std::lower_bound(first, last, j);
+        return it != last && *it == j ? val_[it - col_.begin()] : T{};
+    }
+
+    /// 転置行列
+    sparse_mat transposed() const {
+        sparse_mat res(w_, h_);
+        for (int c : col_) res.ptr_[c + 1]++;
+        for (int j = 0; j < w_; j++) res.ptr_[j + 1] += res.ptr_[j];
+        res.col_.resize(nnz());
+        res.val_.resize(nnz());
+        std::vector<int> pos(res.ptr_.begin(), res.ptr_.end() - 1);
+        // 行の順に置いていくので、転置後の各行も列の昇順になる。
+        for (int i = 0; i < h_; i++) {
+            for (int k = ptr_[i]; k < ptr_[i + 1]; k++) {
+                int p       = pos[col_[k]]++;
+                res.col_[p] = i;
+                res.val_[p] = val_[k];
+            }
+        }
+        return res;
+    }
+
+    /**
+     * @brief 行 [0, h) を pool のスレッドで分担して f(begin, end) を呼ぶ。
+     * @details 各スレッドの非零成分の数がほぼ等しくなるように、 row_ptr を
+     * 二分探索して行を区切る。
+     */
+    template <typename F>
+    void parallel_rows(thread_pool &pool, F const &f) const {
+        int threads = std::max(1, std::min(pool.size(), h_));
+        if (threads == 1) {
+            f(0, h_);
+            return;
+        }
+        auto row = [&](int t) {
+            if (t >= threads) return h_;
+            ll target = 1ll * nnz() * t / threads;
+            return static_cast<int>(
+                std::lower_bound(ptr_.begin(), ptr_.end(), target) -
+                ptr_.begin());
+        };
+        pool.run([&](int t) {
+            if (t < threads) f(row(t), row(t + 1));
+        });
+    }
+};
+
+/**
+ * @brief y = a x を計算する (SpMV) 。
+ * @param[in] pool 使うスレッドの集まり。行を非零成分の数で均等に分担する。
+ * @details 各行の内積は列番号と値を連続に読み、 x だけを間接参照する。 y は
+ * x と別のものでなければならない。各成分の足し込みの順序はスレッドの数によ
+ * らないので、結果はスレッドの数によらずビット単位で一致する。
+ */
+template <typename T>
+void mul_into(sparse_mat<T> const &a, std::vector<T> const &x,
+              std::vector<T> &y, thread_pool &pool) {
+    assert(static_cast<int>(x.size()) == a.width());
+    assert(&x != &y);
+    y.resize(a.height());
+
+    int const *ptr = a.row_ptr().data(), *col = a.col_index().data();
+    T const *val   = a.values().data();
+    a.parallel_rows(pool, [&](int i_begin, int i_end) {
+        for (int i = i_begin; i < i_end; i++) {
+            T sum{};
+            for (int k = ptr[i]; k < ptr[i + 1]; k++) {
+                sum += val[k] * x[col[k]];
+            }
+            y[i] = sum;
+        }
+    });
+}
+
+/// y = a x を threads 個のスレッドで計算する。スレッドは呼び出しごとに作る。
+template <typename T>
+void mul_into(sparse_mat<T> const &a, std::vector<T> const &x,
+              std::vector<T> &y, int threads = 1) {
+    thread_pool pool(threads);
+    mul_into(a, x, y, pool);
+}
+
+template <typename T>
+std::vector<T> operator*(sparse_mat<T> const &a, std::vector<T> const &x) {
+    std::vector<T> y;
+    mul_into(a, x, y);
+    return y;
+}
+
+/*
+ * 反復法 (double)
+ * いずれも x に初期値を与えると、その場で解に更新する。 threads は SpMV に使
+ * うスレッドの数で、スレッドは最初に一度だけ作って全ての反復で使い回す。
+ */
+
+/// ベクトルの内積
+inline double dot_impl(std::vector<double> const &a,
+                       std::vector<double> const &b) {
+    double res = 0;
+    for (int i = 0; i < static_cast<int>(a.size()); i++) res += a[i] * b[i];
+    return res;
+}
+
+/**
+ * @brief 冪乗法で絶対値最大の固有値と固有ベクトルを求める。
+ * @param[inout] x 初期ベクトル (零であってはならない) 。固有ベクトルの近似
+ * (長さ 1) になる。
+ * @return 固有値の近似 (Rayleigh 商)
+ * @details x <- a x / |a x| を、 x の変化が tol 以下になるか max_iter 回まで
+ * 繰り返す。収束の速さは二番目に大きい固有値との比で決まる。 a は正方行列で
+ * なければならない。
+ */
+inline double power_iteration(sparse_mat<double> const &a,
+                              std::vector<double> &x, int max_iter = 1000,
+                              double tol = 1e-10, int threads = 1) {
+    assert(a.height() == a.width());
+    double norm = std::sqrt(dot_impl(x, x));
+    assert(norm > 0);
+    for (auto &v : x) v /= norm;
+
+    thread_pool pool(threads);
+    std::vector<double> y;
+    double lambda = 0;
+    for (int it = 0; it < max_iter; it++) {
+        mul_into(a, x, y, pool);
+        lambda = dot_impl(x, y);
+        norm   = std::sqrt(dot_impl(y, y));
+        if (norm == 0) break;
+        // 固有値が負なら符号が毎回反転するので、向きを揃えて比べる。
+        double sign = lambda < 0 ? -1 : 1, diff = 0;
+        for (int i = 0; i < static_cast<int>(x.size()); i++) {
+            y[i] *= sign / norm;
+            diff = std::max(diff, std::abs(y[i] - x[i]));
+        }
+        std::swap(x, y);
+        if (diff <= tol) break;
+    }
+    return lambda;
+}
+
+/**
+ * @brief 共役勾配法で a x = b を解く。
+ * @return 残差 |b - a x| が tol |b| 以下になったら true
+ * @details a は対称正定値でなければならない。一回の反復は SpMV 一回と O(n)
+ * で、厳密な計算なら n 回以内に収束する。
+ */
+inline bool conjugate_gradient(sparse_mat<double> const &a,
+                               std::vector<double> const &b,
+                               std::vector<double> &x, int max_iter = 1000,
+                               double tol = 1e-10, int threads = 1) {
+    int n = a.height();
+    assert(a.width() == n && static_cast<int>(b.size()) == n);
+    x.resize(n);
+
+    thread_pool pool(threads);
+    std::vector<double> r(n), p, ap;
+    mul_into(a, x, ap, pool);
+    for (int i = 0; i < n; i++) r[i] = b[i] - ap[i];
+    p = r;
+
+    double rr = dot_impl(r, r), limit = tol * tol * dot_impl(b, b);
+    for (int it = 0; it < max_iter && rr > limit; it++) {
+        mul_into(a, p, ap, pool);
+        double alpha = rr / dot_impl(p, ap);
+        for (int i = 0; i < n; i++) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * ap[i];
+        }
+        double rr_next = dot_impl(r, r);
+        double beta    = rr_next / rr;
+        for (int i = 0; i < n; i++) p[i] = r[i] + beta * p[i];
+        rr = rr_next;
+    }
+    return rr <= limit;
+}
+
+/**
+ * @brief Jacobi 法で a x = b を解く。
+ * @return 残差 |b - a x| が tol |b| 以下になったら true
+ * @details x_i <- (b_i - Σ_{j≠i} a_ij x_j) / a_ii を全ての i について同時に
+ * 行う。対角成分は 0 であってはならず、 a が狭義優対角なら収束する。各反復
+ * は SpMV 一回分の計算量で、行ごとに独立なのでスレッドで分担できる。
+ */
+inline bool jacobi(sparse_mat<double> const &a, std::vector<double> const &b,
+                   std::vector<double> &x, int max_iter = 1000,
+                   double tol = 1e-10, int threads = 1) {
+    int n = a.height();
+    assert(a.width() == n && static_cast<int>(b.size()) == n);
+    x.resize(n);
+
+    std::vector<double> diag(n);
+    for (int i = 0; i < n; i++) {
+        diag[i] = a.at(i, i);
+        assert(diag[i] != 0);
+    }
+
+    int const *ptr = a.row_ptr().data(), *col = a.col_index().data();
+    double const *val = a.values().data();
+    double limit      = tol * tol * dot_impl(b, b);
+    thread_pool pool(threads);
+    std::vector<double> next(n), res(n);
+    for (int it = 0; it < max_iter; it++) {
+        a.parallel_rows(pool, [&](int i_begin, int i_end) {
+            for (int i = i_begin; i < i_end; i++) {
+                // sum = (a x)_i
+                double sum = 0;
+                for (int k = ptr[i]; k < ptr[i + 1]; k++) {
+                    sum += val[k] * x[col[k]];
+                }
+                res[i]  = b[i] - sum;
+                next[i] = x[i] + res[i] / diag[i];
+            }
+        });
+        // res は更新前の x での残差
+        if (dot_impl(res, res) <= limit) return true;
+        std::swap(x, next);
+    }
+    mul_into(a, x, res, pool);
+    for (int i = 0; i < n; i++) res[i] = b[i] - res[i];
+    return dot_impl(res, res) <= limit;
+}
+
+} // namespace pcl
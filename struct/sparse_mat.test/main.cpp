@@ -0,0 +1,138 @@
+#include "prelude.hpp"
+
+#include "struct/mat.hpp"
+#include "struct/sparse_mat.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+using triplet = sparse_mat<double>::triplet;
+
+/// 各行に d 個程度の非零成分を持つ n x n のランダムな疎行列の成分。対角成分
+/// には diag を足す。対称にするなら (i, j) と (j, i) に同じ値を置く。
+vector<triplet> random_entries(int n, int d, double diag, bool sym,
+                               mt19937_64 &rng) {
+    uniform_real_distribution<double> dist(-1, 1);
+    vector<triplet> e;
+    for (int i = 0; i < n; i++) {
+        e.emplace_back(i, i, diag);
+        for (int t = 0; t < d; t++) {
+            int j    = rng() % n;
+            double v = dist(rng);
+            e.emplace_back(i, j, v);
+            if (sym) e.emplace_back(j, i, v);
+        }
+    }
+    return e;
+}
+
+/// SpMV が密行列の積と一致し、スレッドの数によらずビット単位で一致するか。
+bool check_spmv(int h, int w, int nnz) {
+    mt19937_64 rng(h + w + nnz);
+    uniform_real_distribution<double> dist(-1, 1);
+    vector<triplet> e;
+    mat<double> dense(h, w);
+    for (int t = 0; t < nnz; t++) {
+        int i = rng() % h, j = rng() % w;
+        double v = dist(rng);
+        e.emplace_back(i, j, v);
+        dense.at(i, j) += v;
+    }
+    sparse_mat<double> a(h, w, e);
+    vector<double> x(w);
+    for (auto &v : x) v = dist(rng);
+
+    vector<double> y1, y4;
+    mul_into(a, x, y1);
+    mul_into(a, x, y4, 4);
+    if (memcmp(y1.data(), y4.data(), h * sizeof(double)) != 0) return false;
+    for (int i = 0; i < h; i++) {
+        double z = 0;
+        for (int j = 0; j < w; j++) z += dense.at(i, j) * x[j];
+        if (abs(z - y1[i]) > 1e-9) return false;
+    }
+
+    auto at = a.transposed();
+    for (int i = 0; i < h; i++)
+        for (int j = 0; j < w; j++)
+            if (at.at(j, i) != a.at(i, j)) return false;
+    return true;
+}
+
+/// 残差 |b - a x| / |b|
+double residual(sparse_mat<double> const &a, vector<double> const &b,
+                vector<double> const &x) {
+    auto ax   = a * x;
+    double rr = 0, bb = 0;
+    for (int i = 0; i < a.height(); i++) {
+        rr += (b[i] - ax[i]) * (b[i] - ax[i]);
+        bb += b[i] * b[i];
+    }
+    return sqrt(rr / bb);
+}
+
+/// 対称正定値 (優対角) な行列で共役勾配法と Jacobi 法が収束するか。
+bool check_solvers(int n) {
+    mt19937_64 rng(n);
+    sparse_mat<double> a(n, n, random_entries(n, 3, 10, true, rng));
+    vector<double> b(n);
+    for (auto &v : b) v = rng() % 100;
+
+    vector<double> x;
+    if (!conjugate_gradient(a, b, x, 1000, 1e-10, 2)) return false;
+    if (residual(a, b, x) > 1e-9) return false;
+    x.assign(n, 0);
+    if (!jacobi(a, b, x, 1000, 1e-10, 2)) return false;
+    return residual(a, b, x) <= 1e-9;
+}
+
+/// 固有値が分かっている行列で冪乗法が収束するか。
+bool check_power(int n) {
+    // 推移確率行列の転置 (列の和が 1) の最大固有値は 1
+    mt19937_64 rng(n);
+    vector<triplet> e;
+    for (int j = 0; j < n; j++) {
+        e.emplace_back(j, j, 0.5);
+        e.emplace_back((j + 1) % n, j, 0.25);
+        e.emplace_back(rng() % n, j, 0.25);
+    }
+    sparse_mat<double> p(n, n, e);
+    vector<double> x(n, 1);
+    double lambda = power_iteration(p, x, 10000, 1e-12, 3);
+    if (abs(lambda - 1) > 1e-9) return false;
+    auto px = p * x;
+    for (int i = 0; i < n; i++)
+        if (abs(px[i] - x[i]) > 1e-9) return false;
+
+    // 対角行列 diag(1, ..., n - 1, -n) の絶対値最大の固有値は -n
+    e.clear();
+    for (int i = 0; i < n; i++) e.emplace_back(i, i, i == n - 1 ? -n : i + 1);
+    x.assign(n, 1);
+    lambda = power_iteration(sparse_mat<double>(n, n, e), x, 10000);
+    return abs(lambda + n) < 1e-6;
+}
+
+int main() {
+    int h, w, k;
+    cin >> h >> w >> k;
+    vector<triplet> e(k);
+    for (auto &t : e) cin >> get<0>(t) >> get<1>(t) >> get<2>(t);
+    sparse_mat<double> a(h, w, e);
+    cout << a.nnz() << endl;
+    cout << a.row_ptr() << endl;
+    cout << a.col_index() << endl;
+    cout << a.values() << endl;
+
+    vector<double> x(w);
+    cin >> x;
+    cout << a * x << endl;
+    cout << a.at(0, 2) << ' ' << a.at(1, 1) << endl;
+
+    cout << check_spmv(100, 130, 2000) << endl;
+    cout << check_spmv(300, 40, 500) << endl;
+    cout << check_spmv(10, 10, 0) << endl;
+    cout << check_solvers(2000) << endl;
+    cout << check_power(500) << endl;
+}
@@ -16,14 +16,22 @@
 
 namespace pcl {
 
-/// DIM 次元ベクトル
-template <int DIM>
+/**
+ * @brief DIM 次元ベクトル
+ * @details 成分の型 T は既定では誤差を許容して比較する dbl 。 ll などの整数
+ * 型にすると、内積や外積、比較は全て誤差なしで行われ、 orientation() などの
+ * 判定が厳密になる。 length() と normalized() は浮動小数点数で計算する。
+ */
+template <int DIM, typename T = dbl>
 class vec {
   private:
     /// 各成分
-    std::array<dbl, DIM> elems_;
+    std::array<T, DIM> elems_;
 
   public:
+    /// 成分の型
+    using value_type = T;
+
     /// デフォルトコンストラクタ
     vec()
         : elems_({}) {
@@ -51,7 +59,7 @@ class vec {
      * @details x 成分、 y 成分ではなく [0] や [1] を使う。範囲外アクセスはチ
      * ェックされる。
      */
-    dbl &operator[](int i) {
+    T &operator[](int i) {
         assert(in_range(0, i, DIM));
         return elems_[i];
     }
@@ -63,19 +71,27 @@ class vec {
      * @details x 成分、 y 成分ではなく [0] や [1] を使う。範囲外アクセスはチ
      * ェックされる。
      */
-    dbl operator[](int i) const {
+    T operator[](int i) const {
         assert(in_range(0, i, DIM));
         return elems_[i];
     }
 
+    /**
+     * @brief ベクトルの長さの二乗。
+     * @return 長さの二乗 (T が整数型なら誤差なし)
+     */
+    T norm2() const {
+        T res = 0;
+        for (T const &x : *this) res += x * x;
+        return res;
+    }
+
     /**
      * @brief ベクトルの長さ。
      * @return 長さ
      */
     dbl length() const {
-        dbl length = 0;
-        for (dbl x : *this) length += x * x;
-        return std::sqrt(length);
+        return std::sqrt(static_cast<double>(norm2()));
     }
 
     /**
@@ -84,9 +100,11 @@ class vec {
      * @details コピーを作って返すので自身を破壊しない。 const 使用可能。
      */
     vec normalized() const {
+        static_assert(!std::is_integral<T>::value,
+                      "normalized() needs a floating-point scalar type");
         vec res = *this;
-        dbl l   = length();
-        for (dbl &x : res) x /= l;
+        T l     = static_cast<T>(length());
+        for (T &x : res) x /= l;
         return res;
     }
 
@@ -130,51 +148,52 @@ class vec {
         return *this;
     }
 
-    vec &operator*=(dbl b) {
-        for (dbl &x : *this) x *= b;
+    vec &operator*=(T const &b) {
+        for (T &x : *this) x *= b;
         return *this;
     }
 
-    vec &operator/=(dbl b) {
-        for (dbl &x : *this) x /= b;
+    vec &operator/=(T const &b) {
+        for (T &x : *this) x /= b;
         return *this;
     }
 };
 
-template <int DIM>
-vec<DIM> operator+(vec<DIM> a, vec<DIM> const &b) {
+template <int DIM, typename T>
+vec<DIM, T> operator+(vec<DIM, T> a, vec<DIM, T> const &b) {
     return a += b;
 }
 
-template <int DIM>
-vec<DIM> operator-(vec<DIM> a, vec<DIM> const &b) {
+template <int DIM, typename T>
+vec<DIM, T> operator-(vec<DIM, T> a, vec<DIM, T> const &b) {
     return a -= b;
 }
 
-template <int DIM>
-vec<DIM> operator*(vec<DIM> a, dbl b) {
+// スカラーの型は vec から決め、 vec<2>(...) * 2.0 のような変換を許す。
+template <int DIM, typename T>
+vec<DIM, T> operator*(vec<DIM, T> a, typename vec<DIM, T>::value_type b) {
     return a *= b;
 }
 
-template <int DIM>
-vec<DIM> operator*(dbl a, vec<DIM> b) {
+template <int DIM, typename T>
+vec<DIM, T> operator*(typename vec<DIM, T>::value_type a, vec<DIM, T> b) {
     return b *= a;
 }
 
-template <int DIM>
-vec<DIM> operator/(vec<DIM> a, dbl b) {
+template <int DIM, typename T>
+vec<DIM, T> operator/(vec<DIM, T> a, typename vec<DIM, T>::value_type b) {
     return a /= b;
 }
 
-template <int DIM>
-bool operator==(vec<DIM> const &a, vec<DIM> const &b) {
+template <int DIM, typename T>
+bool operator==(vec<DIM, T> const &a, vec<DIM, T> const &b) {
     for (int i = 0; i < DIM; i++)
         if (a[i] != b[i]) return false;
     return true;
 }
 
-template <int DIM>
-inline bool operator!=(vec<DIM> const &a, vec<DIM> const &b) {
+template <int DIM, typename T>
+inline bool operator!=(vec<DIM, T> const &a, vec<DIM, T> const &b) {
     return !(a == b);
 }
 
@@ -182,9 +201,9 @@ inline bool operator!=(vec<DIM> const &a, vec<DIM> const &b) {
  * @brief 二つのベクトルの内積をとる。
  * @return 内積
  */
-template <int DIM>
-dbl dot(vec<DIM> const &a, vec<DIM> const &b) {
-    dbl res = 0.0;
+template <int DIM, typename T>
+T dot(vec<DIM, T> const &a, vec<DIM, T> const &b) {
+    T res = 0;
     for (int i = 0; i < DIM; i++) res += a[i] * b[i];
     return res;
 }
@@ -194,8 +213,9 @@ dbl dot(vec<DIM> const &a, vec<DIM> const &b) {
  * @return 外積 (z 座標のみをもつ **三次元** ベクトルで返される)
  * @details 返されるベクトルの x, y 座標はどちらも 0 になる。
  */
-vec<3> cross(vec<2> const &a, vec<2> const &b) {
-    return {0, 0, a[0] * b[1] - a[1] * b[0]};
+template <typename T>
+vec<3, T> cross(vec<2, T> const &a, vec<2, T> const &b) {
+    return {T(0), T(0), a[0] * b[1] - a[1] * b[0]};
 }
 
 /**
@@ -203,20 +223,35 @@ vec<3> cross(vec<2> const &a, vec<2> const &b) {
  * @return 外積
  * @details 外積は二次元と三次元のベクトルにのみ提供されている。
  */
-vec<3> cross(vec<3> const &a, vec<3> const &b) {
+template <typename T>
+vec<3, T> cross(vec<3, T> const &a, vec<3, T> const &b) {
     return {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2],
             a[0] * b[1] - a[1] * b[0]};
 }
 
+/**
+ * @brief 三点 a, b, c の向きを判定する。
+ * @return a -> b -> c が反時計回りなら +1 、時計回りなら -1 、一直線上なら 0
+ * @details (b - a) と (c - a) の外積の符号。 T が整数型なら誤差なしで、分岐
+ * もせずに求まる。座標の絶対値が M 以下なら、途中の値は 8M^2 以下なので、
+ * ll なら M < 10^9 程度まで溢れない。
+ */
+template <typename T>
+int orientation(vec<2, T> const &a, vec<2, T> const &b, vec<2, T> const &c) {
+    T z = (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+    return (z > T(0)) - (z < T(0));
+}
+
 /**
  * @brief 二つのベクトルが平行かどうか判定する。
  * @return 平行なら true
  * @details 現在の実装は、外積をとってその大きさが 0 となれば平行と判断すると
- * いうもの。
+ * いうもの。 T が整数型なら外積の長さの二乗で誤差なしに判定する。
  */
-template <int DIM>
-bool is_parallel(vec<DIM> const &a, vec<DIM> const &b) {
-    return cross(a, b).length() == 0;
+template <int DIM, typename T>
+bool is_parallel(vec<DIM, T> const &a, vec<DIM, T> const &b) {
+    auto c = cross(a, b);
+    return std::is_integral<T>::value ? c.norm2() == T(0) : c.length() == 0;
 }
 
 /**
@@ -226,8 +261,8 @@ bool is_parallel(vec<DIM> const &a, vec<DIM> const &b) {
  * @details ベクトルが平行であることは前提とする。平行でないベクトルについて呼
  * び出された場合は assert により強制終了する。
  */
-template <int DIM>
-bool is_same_direction(vec<DIM> const &a, vec<DIM> const &b) {
+template <int DIM, typename T>
+bool is_same_direction(vec<DIM, T> const &a, vec<DIM, T> const &b) {
     // this function can only be applied with parallel vecs.
     assert(is_parallel(a, b));
 
@@ -239,15 +274,15 @@ bool is_same_direction(vec<DIM> const &a, vec<DIM> const &b) {
 }
 
 /// ストリーム入力演算子
-template <int DIM>
-std::istream &operator>>(std::istream &is, vec<DIM> &v) {
+template <int DIM, typename T>
+std::istream &operator>>(std::istream &is, vec<DIM, T> &v) {
     for (int i = 0; i < DIM; i++) is >> v[i];
     return is;
 }
 
 /// ストリーム出力演算子
-template <int DIM>
-std::ostream &operator<<(std::ostream &os, vec<DIM> const &v) {
+template <int DIM, typename T>
+std::ostream &operator<<(std::ostream &os, vec<DIM, T> const &v) {
     os << '(';
     for (int i = 0; i < DIM; i++) {
         if (i != 0) os << ',';
@@ -263,9 +298,15 @@ using vec2 = vec<2>;
 /// 三次元ベクトルの型エイリアス
 using vec3 = vec<3>;
 
+/// 整数座標の二次元ベクトルの型エイリアス
+using vec2i = vec<2, ll>;
+
+/// 整数座標の三次元ベクトルの型エイリアス
+using vec3i = vec<3, ll>;
+
 /// 「座標」を表す型 (実体はエイリアス)
-template <int DIM>
-using coord = vec<DIM>;
+template <int DIM, typename T = dbl>
+using coord = vec<DIM, T>;
 
 /// 二次元座標の型エイリアス
 using coord2 = vec<2>;
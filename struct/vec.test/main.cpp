@@ -34,4 +34,15 @@ int main() {
         cout << is_parallel(x, y) << endl;
         cout << is_same_direction(x, y) << endl;
     }
+
+    // 整数座標では、 dbl では丸められてしまう向きの差も正しく判定できる。
+    vec2i p, q, o;
+    cin >> p >> q >> o;
+    cout << orientation(p, q, o) << ' ' << orientation(p, o, q) << ' '
+         << orientation(p, q, p + q) << endl;
+    cout << orientation(vec2(p[0], p[1]), vec2(q[0], q[1]),
+                        vec2(o[0], o[1]))
+         << endl;
+    cout << dot(q, o) << ' ' << cross(q, o) << ' ' << q.norm2() << endl;
+    cout << is_parallel(q, o) << ' ' << is_parallel(q, q * 3) << endl;
 }
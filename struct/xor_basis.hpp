@@ -0,0 +1,133 @@
+/**
+ * @file struct/xor_basis.hpp
+ * @brief GF(2) 上のベクトル空間の基底を逐次的に管理する
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace pcl {
+
+/**
+ * @brief n ビットのベクトルの xor 基底
+ * @details ベクトルは bitmat の行と同じく、 64 bit ごとに ull に詰めた語の列
+ * (j ビット目は j / 64 語目の j % 64 ビット目) で表す。最上位ビットが j であ
+ * る基底を高々一つずつ持つ。挿入も最大値の質問も O(n^2 / 64) 。 n <= 64 な
+ * ら ull をそのまま渡せる。
+ * - insert: ベクトルを加え、基底が増えたかどうかを返す。
+ * - contains: ベクトルが張る空間に入っているかどうか。
+ * - max_xor: x に基底のベクトルをいくつか xor してできる最大値。
+ */
+class xor_basis {
+  private:
+    int n_;
+
+    /// 一つのベクトルの語数
+    int words_;
+
+    /// j 番目の words_ 語が、最上位ビットが j である基底 (なければ 0)
+    std::vector<ull> v_;
+
+    /// 最上位ビットが j である基底があるか
+    std::vector<char> has_;
+
+    int rank_;
+
+    ull *row(int j) {
+        return v_.data() + static_cast<std::size_t>(j) * words_;
+    }
+
+    ull const *row(int j) const {
+        return v_.data() + static_cast<std::size_t>(j) * words_;
+    }
+
+    /**
+     * @brief x を基底で掃き出す。
+     * @return 残った x の最上位ビット。 x が 0 になれば -1 。
+     */
+    int reduce_impl(std::vector<ull> &x) const {
+        for (int j = n_ - 1; j >= 0; j--) {
+            if (!(x[j / 64] >> (j % 64) & 1)) continue;
+            if (!has_[j]) return j;
+            ull const *b = row(j);
+            for (int k = 0; k <= j / 64; k++) x[k] ^= b[k];
+        }
+        return -1;
+    }
+
+  public:
+    /// n ビットのベクトルを扱う、空の基底
+    xor_basis(int n)
+        : n_(n)
+        , words_((n + 63) / 64)
+        , v_(static_cast<std::size_t>(n) * words_)
+        , has_(n)
+        , rank_(0) {
+        assert(n >= 0);
+    }
+
+    /// 扱うベクトルのビット数
+    int bits() const {
+        return n_;
+    }
+
+    /// 基底の大きさ (張る空間の次元)
+    int rank() const {
+        return rank_;
+    }
+
+    /**
+     * @brief x を加える。
+     * @return x がそれまでの基底と一次独立で、基底が増えたら true
+     */
+    bool insert(std::vector<ull> x) {
+        assert(static_cast<int>(x.size()) == words_);
+        int j = reduce_impl(x);
+        if (j < 0) return false;
+        std::copy(x.begin(), x.end(), row(j));
+        has_[j] = true;
+        rank_++;
+        return true;
+    }
+
+    bool insert(ull x) {
+        assert(n_ <= 64);
+        return insert(std::vector<ull>{x});
+    }
+
+    /// x が基底の張る空間に入っているか
+    bool contains(std::vector<ull> x) const {
+        assert(static_cast<int>(x.size()) == words_);
+        return reduce_impl(x) < 0;
+    }
+
+    bool contains(ull x) const {
+        assert(n_ <= 64);
+        return contains(std::vector<ull>{x});
+    }
+
+    /**
+     * @brief x に基底のベクトルをいくつか xor してできる最大値
+     * @details 上のビットから順に、立っていなければその基底を xor する。
+     */
+    std::vector<ull> max_xor(std::vector<ull> x) const {
+        assert(static_cast<int>(x.size()) == words_);
+        for (int j = n_ - 1; j >= 0; j--) {
+            if (!has_[j] || (x[j / 64] >> (j % 64) & 1)) continue;
+            ull const *b = row(j);
+            for (int k = 0; k <= j / 64; k++) x[k] ^= b[k];
+        }
+        return x;
+    }
+
+    ull max_xor(ull x = 0) const {
+        assert(n_ <= 64);
+        return max_xor(std::vector<ull>{x})[0];
+    }
+};
+
+} // namespace pcl
@@ -0,0 +1,56 @@
+#include "prelude.hpp"
+
+#include "struct/bitmat.hpp"
+#include "struct/xor_basis.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+/// 語の境界をまたぐ幅で、基底の大きさが bitmat の階数と一致するか。
+bool check_wide(int n, int m) {
+    mt19937_64 rng(n + m);
+    xor_basis xb(n);
+    bitmat a(m, n);
+    int words = (n + 63) / 64;
+    for (int i = 0; i < m; i++) {
+        // 張る空間を小さくするため、上位のビットだけにする。
+        vector<ull> x(words);
+        for (int j = n - n / 4; j < n; j++) {
+            if (rng() & 1) x[j / 64] |= 1ull << (j % 64);
+        }
+        bool in = xb.contains(x);
+        if (xb.insert(x) == in) return false;
+        copy(x.begin(), x.end(), a[i]);
+        bitmat b(i + 1, n);
+        copy(a[0], a[0] + (i + 1) * words, b[0]);
+        if (xb.rank() != b.rank()) return false;
+    }
+    return true;
+}
+
+int main() {
+    int n;
+    cin >> n;
+    vector<ull> a(n);
+    for (auto &x : a) cin >> x;
+
+    xor_basis xb(64);
+    for (int i = 0; i < n; i++) cout << xb.insert(a[i]) << " \n"[i == n - 1];
+    cout << xb.rank() << endl;
+    cout << xb.max_xor() << endl;
+
+    // 全ての部分集合の xor の最大値と比べる。
+    ull best = 0;
+    for (int s = 0; s < (1 << n); s++) {
+        ull x = 0;
+        for (int i = 0; i < n; i++)
+            if (s >> i & 1) x ^= a[i];
+        best = max(best, x);
+    }
+    cout << (best == xb.max_xor()) << endl;
+
+    cout << check_wide(200, 80) << endl;
+    cout << check_wide(64, 100) << endl;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file util/string.hpp
+ * @brief 文字列に関するアルゴリズムたち。
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace pcl {
+
+/**
+ * @brief 文字列の各接頭辞について、最長の (真の) border の長さを求める。
+ * @param[in] s 文字列
+ * @return res[i] は s[0..i+1] の接頭辞かつ接尾辞である最長の真部分文字列の長
+ * さ。
+ * @details KMP 法の失敗関数そのもの。計算量は O(|s|) 。
+ */
+inline std::vector<int> prefix_function(std::string const &s) {
+    int n = s.size();
+    std::vector<int> res(n, 0);
+    for (int i = 1; i < n; i++) {
+        int k = res[i - 1];
+        while (k > 0 && s[i] != s[k]) k = res[k - 1];
+        if (s[i] == s[k]) k++;
+        res[i] = k;
+    }
+    return res;
+}
+
+/**
+ * @brief KMP 法でテキスト中のパターンの出現位置を全て求める。
+ * @param[in] text テキスト
+ * @param[in] p パターン (空でない)
+ * @return p が出現する開始位置の昇順のリスト
+ * @details 計算量は O(|text| + |p|) 。
+ */
+inline std::vector<int> kmp_search(std::string const &text,
+                                   std::string const &p) {
+    std::vector<int> res;
+    if (p.empty()) return res;
+    auto fail = prefix_function(p);
+    int m     = p.size();
+    int k     = 0;
+    for (int i = 0; i < static_cast<int>(text.size()); i++) {
+        while (k > 0 && text[i] != p[k]) k = fail[k - 1];
+        if (text[i] == p[k]) k++;
+        if (k == m) {
+            res.push_back(i + 1 - m);
+            k = fail[k - 1];
+        }
+    }
+    return res;
+}
+
+/**
+ * @brief Z algorithm
+ * @param[in] s 文字列
+ * @return res[i] は s と s[i..] の最長共通接頭辞の長さ。 res[0] = |s| 。
+ * @details 計算量は O(|s|) 。パターン p の検索には p + 区切り文字 + text に
+ * 対して適用して、値が |p| になる位置を探せばよい。
+ */
+inline std::vector<int> z_algorithm(std::string const &s) {
+    int n = s.size();
+    std::vector<int> res(n, 0);
+    if (n == 0) return res;
+    res[0] = n;
+    // [l, r) は今までに見つかった、 s の接頭辞と一致する区間のうち r が最大
+    // のもの。
+    for (int i = 1, l = 0, r = 0; i < n; i++) {
+        int k = i < r ? std::min(r - i, res[i - l]) : 0;
+        while (i + k < n && s[k] == s[i + k]) k++;
+        res[i] = k;
+        if (i + k > r) l = i, r = i + k;
+    }
+    return res;
+}
+
+/**
+ * @brief Manacher 法で、全ての中心について最長の回文の長さを求める。
+ * @param[in] s 文字列
+ * @return 長さ 2|s|-1 の配列 res 。 res[k] は、 k が偶数なら s[k/2] を中心と
+ * する、奇数なら s[(k-1)/2] と s[(k+1)/2] の間を中心とする最長の回文の長さ。
+ * @details s の文字の間と両端に区切り文字を挟んだ文字列 t (長さ 2|s|+1) を考
+ * えると、偶数長の回文も奇数長の回文として扱える。実際に t を作る必要はなく、
+ * 比較する二つの位置は常に偶奇が一致するので、区切り文字同士は常に一致すると
+ * して添字だけで処理する。計算量は O(|s|) 。
+ * 区間 s[l..r] が回文であることは `res[l + r - 1] >= r - l` と同値である。
+ */
+inline std::vector<int> manacher(std::string const &s) {
+    int n = s.size();
+    if (n == 0) return {};
+    int m = 2 * n + 1;
+
+    // t の a 番目と b 番目 (a, b は偶奇が同じ) が一致するかどうか。
+    auto same = [&](int a, int b) {
+        return a % 2 == 0 || s[a / 2] == s[b / 2];
+    };
+
+    // rad[i] は t[i-rad[i]+1..i+rad[i]] が回文となる最大の値。
+    // [c - rad[c] + 1, r) は今までに見つかった回文のうち r が最大のもの。
+    std::vector<int> rad(m);
+    for (int i = 0, c = 0, r = 0; i < m; i++) {
+        int k = i < r ? std::min(rad[2 * c - i], r - i) : 1;
+        while (i - k >= 0 && i + k < m && same(i - k, i + k)) k++;
+        rad[i] = k;
+        if (i + k > r) c = i, r = i + k;
+    }
+
+    std::vector<int> res(2 * n - 1);
+    for (int k = 0; k < 2 * n - 1; k++) res[k] = rad[k + 1] - 1;
+    return res;
+}
+
+} // namespace pcl
@@ -0,0 +1,25 @@
+#include "prelude.hpp"
+
+#include "util/string.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+int main() {
+    string t, p;
+    cin >> t >> p;
+
+    for (int x : prefix_function(p)) cout << x << ' ';
+    cout << endl;
+
+    for (int x : kmp_search(t, p)) cout << x << ' ';
+    cout << endl;
+
+    for (int x : z_algorithm(t)) cout << x << ' ';
+    cout << endl;
+
+    for (int x : manacher(t)) cout << x << ' ';
+    cout << endl;
+}
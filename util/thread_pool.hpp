@@ -0,0 +1,108 @@
+/**
+ * @file util/thread_pool.hpp
+ * @brief 使い回せる固定数のスレッドの集まり。
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pcl {
+
+/**
+ * @brief 固定数のスレッドを持ち、同じ仕事を全てのスレッドで一斉に実行する。
+ * @details run(f) は各スレッド t (0 <= t < size()) で f(t) を呼び、全て終わ
+ * るまで待つ。 t = 0 は呼び出したスレッド自身が担当するので、作るスレッドは
+ * size() - 1 個。スレッドは構築時に一度だけ作り、破棄時に join するので、
+ * 行列の冪のように何度も並列に計算するときに毎回スレッドを作る費用がかから
+ * ない。 run() を複数のスレッドから同時に呼んではならない。
+ */
+class thread_pool {
+  private:
+    int n_;
+    std::vector<std::thread> workers_;
+
+    std::mutex mtx_;
+    std::condition_variable start_cv_, done_cv_;
+
+    /// 実行中の仕事。 gen_ が変わってから pending_ が 0 になるまで有効。
+    std::function<void(int)> job_;
+
+    /// 何番目の仕事か
+    ull gen_ = 0;
+
+    /// まだ終わっていないスレッド (呼び出し元以外) の数
+    int pending_ = 0;
+
+    bool stop_ = false;
+
+    void worker_impl(int t) {
+        ull seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lk(mtx_);
+                start_cv_.wait(lk, [&] { return stop_ || gen_ != seen; });
+                if (stop_) return;
+                seen = gen_;
+            }
+            job_(t);
+            {
+                std::lock_guard<std::mutex> lk(mtx_);
+                if (--pending_ == 0) done_cv_.notify_one();
+            }
+        }
+    }
+
+  public:
+    /// threads 個 (1 未満なら 1 個) のスレッドで実行する集まりを作る。
+    explicit thread_pool(int threads)
+        : n_(std::max(1, threads)) {
+        for (int t = 1; t < n_; t++) {
+            workers_.emplace_back([this, t] { worker_impl(t); });
+        }
+    }
+
+    thread_pool(thread_pool const &) = delete;
+    thread_pool &operator=(thread_pool const &) = delete;
+
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            stop_ = true;
+        }
+        start_cv_.notify_all();
+        for (auto &th : workers_) th.join();
+    }
+
+    /// スレッドの数 (呼び出し元を含む)
+    int size() const {
+        return n_;
+    }
+
+    /// 各 t (0 <= t < size()) について f(t) を並列に呼び、終わるまで待つ。
+    template <typename F>
+    void run(F const &f) {
+        if (n_ == 1) {
+            f(0);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            job_     = [&f](int t) { f(t); };
+            pending_ = n_ - 1;
+            gen_++;
+        }
+        start_cv_.notify_all();
+        f(0);
+        std::unique_lock<std::mutex> lk(mtx_);
+        done_cv_.wait(lk, [&] { return pending_ == 0; });
+    }
+};
+
+} // namespace pcl
@@ -0,0 +1,38 @@
+#include "prelude.hpp"
+
+#include "util/thread_pool.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+int main() {
+    int threads, rounds;
+    cin >> threads >> rounds;
+
+    // 各ラウンドで全てのスレッドがちょうど一回ずつ呼ばれる。
+    thread_pool pool(threads);
+    vector<ll> cnt(pool.size());
+    vector<thread::id> ids(pool.size());
+    for (int r = 0; r < rounds; r++) {
+        pool.run([&](int t) {
+            cnt[t] += r;
+            ids[t] = this_thread::get_id();
+        });
+    }
+    cout << pool.size() << endl;
+    for (int t = 0; t < pool.size(); t++) {
+        cout << cnt[t] << " \n"[t == pool.size() - 1];
+    }
+    // t = 0 は呼び出し元のスレッドで、他は別々のスレッド。
+    cout << (ids[0] == this_thread::get_id()) << ' '
+         << (set<thread::id>(ids.begin(), ids.end()).size() == ids.size())
+         << endl;
+
+    // スレッドが一つなら呼び出し元で実行するだけ。
+    thread_pool single(0);
+    int x = 0;
+    single.run([&](int t) { x += t + 1; });
+    cout << single.size() << ' ' << x << endl;
+}
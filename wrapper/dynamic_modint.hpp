@@ -0,0 +1,405 @@
+/**
+ * @file wrapper/dynamic_modint.hpp
+ * @brief 実行時に法を決める、自動的に剰余をとる整数型。
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include "../math/alg.hpp"
+
+#include <cassert>
+#include <iostream>
+
+namespace pcl {
+
+/**
+ * @brief Barrett reduction による、実行時に決まる法 m (1 <= m < 2^32) での
+ * 乗算。
+ * @details im = ceil(2^64 / m) を前計算しておくと、 0 <= x < 2^64 につい
+ * て q = floor(x im / 2^64) は floor(x / m) か、それより 1 大きい値になる。
+ * よって x - q m を求めて負なら m を足せば x mod m になる。 128 bit の乗算一
+ * 回と補正一回で済み、除算は要らない。
+ */
+class barrett {
+  private:
+    /// 法
+    unsigned m_;
+
+    /// ceil(2^64 / m)
+    ull im_;
+
+  public:
+    explicit barrett(unsigned m)
+        : m_(m)
+        , im_(ull(-1) / m + 1) {
+        assert(m >= 1);
+    }
+
+    /// 法
+    unsigned mod() const {
+        return m_;
+    }
+
+    /// x mod m
+    unsigned reduce(ull x) const {
+        // m == 1 のときは im_ が 0 に溢れて正しく求まらない。
+        if (m_ == 1) return 0;
+        ull q = static_cast<ull>((static_cast<__uint128_t>(x) * im_) >> 64);
+        // x - q m は [-m, m) に入るので、 2^64 を法として計算して符号付きと
+        // みなせば正しい値になる。
+        ll r = static_cast<ll>(x - q * m_);
+        return static_cast<unsigned>(r < 0 ? r + m_ : r);
+    }
+
+    /// a b mod m (0 <= a, b < m)
+    unsigned mul(unsigned a, unsigned b) const {
+        return reduce(static_cast<ull>(a) * b);
+    }
+};
+
+/**
+ * @brief 実行時に決めた法で自動的に剰余をとる整数型。
+ * @details modint と同じように使えるが、法はテンプレート引数ではなく
+ * set_mod() で実行時に設定する。法はスレッドごとに一つ持つので、別々のスレッ
+ * ドで別々の法を使ってよい。同じスレッドで複数の法を同時に使いたければ、 ID
+ * を変えて別の型にする。 mod_guard を使うと、スコープの間だけ法を切り替え、
+ * 抜けるときに元に戻す。
+ * 法は 1 以上 2^32 未満でなければならない。法を変えると、それまでに作った値
+ * は意味を失う (再度正規化はされない) 。乗算は barrett::mul() 、加減算は比較
+ * と一回の補正で行う。
+ */
+template <int ID = -1>
+class dynamic_modint {
+  private:
+    /// 値 (0 <= v_ < mod())
+    unsigned v_;
+
+    /// このスレッドでの法
+    static barrett &bt() {
+        static thread_local barrett b(P7);
+        return b;
+    }
+
+    template <int ID_>
+    friend bool operator==(dynamic_modint<ID_> const &a,
+                           dynamic_modint<ID_> const &b);
+
+    template <int ID_>
+    friend bool operator<(dynamic_modint<ID_> const &a,
+                          dynamic_modint<ID_> const &b);
+
+  public:
+    /// 法を設定する (1 <= m < 2^32) 。既定は P7 。
+    static void set_mod(ll m) {
+        assert(in_range(1ll, m, 1ll << 32));
+        bt() = barrett(m);
+    }
+
+    /// 現在の法
+    static ll mod() {
+        return bt().mod();
+    }
+
+    /**
+     * @brief スコープの間だけ法を切り替える。
+     * @details 構築時に法を設定し、破棄時にそれまでの法に戻す。入れ子にして
+     * もよい。
+     */
+    class mod_guard {
+      private:
+        ll old_;
+
+      public:
+        explicit mod_guard(ll m)
+            : old_(mod()) {
+            set_mod(m);
+        }
+
+        mod_guard(mod_guard const &) = delete;
+        mod_guard &operator=(mod_guard const &) = delete;
+
+        ~mod_guard() {
+            set_mod(old_);
+        }
+    };
+
+    /// デフォルトコンストラクタ
+    dynamic_modint()
+        : v_(0) {
+    }
+
+    /**
+     * @brief 指定された値で初期化するコンストラクタ。
+     * @details 指定された値は勝手に正規化されるため、 `0 <= init < mod()` を
+     * 満たしていなくてもよい。
+     */
+    dynamic_modint(ll init) {
+        ll m = mod();
+        if (0 <= init && init < m) {
+            v_ = init;
+        } else {
+            init %= m;
+            v_ = init < 0 ? init + m : init;
+        }
+    }
+
+    /// `ll` へのキャスト演算子。
+    explicit operator ll() const {
+        return v_;
+    }
+
+    /*
+     * 破壊的演算 (<> dynamic_modint)
+     */
+
+    dynamic_modint &operator+=(dynamic_modint const &o) {
+        unsigned m = bt().mod();
+        v_ += o.v_;
+        // 法が 2^31 以上だと v_ + o.v_ は溢れうるので、溢れも判定する。
+        if (v_ < o.v_ || v_ >= m) v_ -= m;
+        return *this;
+    }
+
+    dynamic_modint &operator-=(dynamic_modint const &o) {
+        unsigned m = bt().mod();
+        if (v_ < o.v_) v_ += m;
+        v_ -= o.v_;
+        return *this;
+    }
+
+    dynamic_modint &operator*=(dynamic_modint const &o) {
+        v_ = bt().mul(v_, o.v_);
+        return *this;
+    }
+
+    dynamic_modint &operator/=(dynamic_modint const &o) {
+        return *this *= dynamic_modint(inv_mod(o.v_, mod()));
+    }
+
+    /*
+     * 破壊的演算 (<> scalar)
+     */
+
+    dynamic_modint &operator+=(ll o) {
+        return *this += dynamic_modint(o);
+    }
+
+    dynamic_modint &operator-=(ll o) {
+        return *this -= dynamic_modint(o);
+    }
+
+    dynamic_modint &operator*=(ll o) {
+        return *this *= dynamic_modint(o);
+    }
+
+    dynamic_modint &operator/=(ll o) {
+        return *this /= dynamic_modint(o);
+    }
+
+    /*
+     * 単項演算
+     */
+
+    dynamic_modint operator-() const {
+        return dynamic_modint() -= *this;
+    }
+
+    dynamic_modint &operator++() {
+        return *this += dynamic_modint(1);
+    }
+
+    dynamic_modint &operator--() {
+        return *this -= dynamic_modint(1);
+    }
+};
+
+/*
+ * 二項関係 (dynamic_modint <> dynamic_modint)
+ */
+
+template <int ID>
+bool operator==(dynamic_modint<ID> const &a, dynamic_modint<ID> const &b) {
+    return a.v_ == b.v_;
+}
+
+template <int ID>
+bool operator!=(dynamic_modint<ID> const &a, dynamic_modint<ID> const &b) {
+    return !(a == b);
+}
+
+template <int ID>
+bool operator<(dynamic_modint<ID> const &a, dynamic_modint<ID> const &b) {
+    return a.v_ < b.v_;
+}
+
+template <int ID>
+bool operator>(dynamic_modint<ID> const &a, dynamic_modint<ID> const &b) {
+    return b < a;
+}
+
+template <int ID>
+bool operator<=(dynamic_modint<ID> const &a, dynamic_modint<ID> const &b) {
+    return !(b < a);
+}
+
+template <int ID>
+bool operator>=(dynamic_modint<ID> const &a, dynamic_modint<ID> const &b) {
+    return !(a < b);
+}
+
+/*
+ * 二項関係 (dynamic_modint <> scalar)
+ */
+
+template <int ID>
+bool operator==(dynamic_modint<ID> const &a, ll b) {
+    return a == dynamic_modint<ID>(b);
+}
+
+template <int ID>
+bool operator!=(dynamic_modint<ID> const &a, ll b) {
+    return a != dynamic_modint<ID>(b);
+}
+
+template <int ID>
+bool operator<(dynamic_modint<ID> const &a, ll b) {
+    return a < dynamic_modint<ID>(b);
+}
+
+template <int ID>
+bool operator>(dynamic_modint<ID> const &a, ll b) {
+    return a > dynamic_modint<ID>(b);
+}
+
+template <int ID>
+bool operator<=(dynamic_modint<ID> const &a, ll b) {
+    return a <= dynamic_modint<ID>(b);
+}
+
+template <int ID>
+bool operator>=(dynamic_modint<ID> const &a, ll b) {
+    return a >= dynamic_modint<ID>(b);
+}
+
+/*
+ * 二項関係 (scalar <> dynamic_modint)
+ */
+
+template <int ID>
+bool operator==(ll a, dynamic_modint<ID> const &b) {
+    return dynamic_modint<ID>(a) == b;
+}
+
+template <int ID>
+bool operator!=(ll a, dynamic_modint<ID> const &b) {
+    return dynamic_modint<ID>(a) != b;
+}
+
+template <int ID>
+bool operator<(ll a, dynamic_modint<ID> const &b) {
+    return dynamic_modint<ID>(a) < b;
+}
+
+template <int ID>
+bool operator>(ll a, dynamic_modint<ID> const &b) {
+    return dynamic_modint<ID>(a) > b;
+}
+
+template <int ID>
+bool operator<=(ll a, dynamic_modint<ID> const &b) {
+    return dynamic_modint<ID>(a) <= b;
+}
+
+template <int ID>
+bool operator>=(ll a, dynamic_modint<ID> const &b) {
+    return dynamic_modint<ID>(a) >= b;
+}
+
+/*
+ * 二項演算
+ */
+
+template <int ID>
+dynamic_modint<ID> operator+(dynamic_modint<ID> a,
+                             dynamic_modint<ID> const &b) {
+    return a += b;
+}
+
+template <int ID>
+dynamic_modint<ID> operator-(dynamic_modint<ID> a,
+                             dynamic_modint<ID> const &b) {
+    return a -= b;
+}
+
+template <int ID>
+dynamic_modint<ID> operator*(dynamic_modint<ID> a,
+                             dynamic_modint<ID> const &b) {
+    return a *= b;
+}
+
+template <int ID>
+dynamic_modint<ID> operator/(dynamic_modint<ID> a,
+                             dynamic_modint<ID> const &b) {
+    return a /= b;
+}
+
+template <int ID>
+dynamic_modint<ID> operator+(dynamic_modint<ID> a, ll b) {
+    return a += b;
+}
+
+template <int ID>
+dynamic_modint<ID> operator-(dynamic_modint<ID> a, ll b) {
+    return a -= b;
+}
+
+template <int ID>
+dynamic_modint<ID> operator*(dynamic_modint<ID> a, ll b) {
+    return a *= b;
+}
+
+template <int ID>
+dynamic_modint<ID> operator/(dynamic_modint<ID> a, ll b) {
+    return a /= b;
+}
+
+template <int ID>
+dynamic_modint<ID> operator+(ll a, dynamic_modint<ID> const &b) {
+    return dynamic_modint<ID>(a) += b;
+}
+
+template <int ID>
+dynamic_modint<ID> operator-(ll a, dynamic_modint<ID> const &b) {
+    return dynamic_modint<ID>(a) -= b;
+}
+
+template <int ID>
+dynamic_modint<ID> operator*(ll a, dynamic_modint<ID> const &b) {
+    return dynamic_modint<ID>(a) *= b;
+}
+
+template <int ID>
+dynamic_modint<ID> operator/(ll a, dynamic_modint<ID> const &b) {
+    return dynamic_modint<ID>(a) /= b;
+}
+
+/*
+ * ストリーム入出力
+ */
+
+/// ストリーム出力演算子
+template <int ID>
+std::ostream &operator<<(std::ostream &os, dynamic_modint<ID> const &x) {
+    return os << static_cast<ll>(x);
+}
+
+/// ストリーム入力演算子
+template <int ID>
+std::istream &operator>>(std::istream &is, dynamic_modint<ID> &x) {
+    ll v;
+    is >> v, x = v;
+    return is;
+}
+
+} // namespace pcl
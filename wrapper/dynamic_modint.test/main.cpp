@@ -0,0 +1,69 @@
+#include "prelude.hpp"
+
+#include "wrapper/dynamic_modint.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+using dmint = dynamic_modint<>;
+
+/// 現在の法で、同じ操作列を ll (mul_mod, inv_mod) と dmint で行い、結果が一
+/// 致するか。
+bool same_as_reference(int n) {
+    ll const m = dmint::mod();
+    mt19937_64 rng(m);
+    ll a    = 1;
+    dmint b = 1;
+    for (int i = 0; i < n; i++) {
+        ll x = static_cast<ll>(rng() >> 2) - (1ll << 60);
+        ll y = (x % m + m) % m;
+        switch (i % 5) {
+        case 0: a = (a + y) % m, b += x; break;
+        case 1: a = (a - y + m) % m, b -= x; break;
+        case 2: a = mul_mod(a, y, m), b *= x; break;
+        case 3: a = (m - a) % m, b = -b; break;
+        case 4:
+            if (gcd(a + 1, m) != 1) break;
+            a = mul_mod(a, inv_mod(a + 1, m), m), b /= b + 1;
+        }
+        if (a != static_cast<ll>(b)) return false;
+    }
+    return true;
+}
+
+int main() {
+    ll m;
+    cin >> m;
+    dmint::set_mod(m);
+    dmint x, y;
+    cin >> x >> y;
+    cout << x + y << ' ' << x - y << ' ' << x * y << ' ' << x / y << endl;
+    cout << 2ll + y << ' ' << 2ll - y << ' ' << 2ll * y << ' ' << 2ll / y
+         << endl;
+    cout << (x == y) << (x != y) << (x < y) << (x <= y) << (x > y)
+         << (x >= y) << endl;
+    cout << (x < 4ll) << (x > 4ll) << (x <= 3ll) << (x >= 10ll)
+         << (4ll < x) << (4ll > x) << (3ll <= x) << (10ll >= x) << endl;
+
+    for (ll p : {1ll, 2ll, 998244353ll, 1000000007ll, 4294967291ll,
+                 4294967295ll, 123456789ll}) {
+        dmint::mod_guard g(p);
+        cout << same_as_reference(100000);
+    }
+    cout << ' ' << dmint::mod() << endl;
+
+    // 法はスレッドごとに独立。
+    ll other = 0;
+    thread t([&] {
+        dmint::set_mod(11);
+        other = static_cast<ll>(dmint(100));
+    });
+    t.join();
+    cout << other << ' ' << dmint(100) << endl;
+
+    // ID が違えば同じスレッドでも別の法を持てる。
+    dynamic_modint<1>::set_mod(13);
+    cout << dynamic_modint<1>(100) << ' ' << dmint(100) << endl;
+}
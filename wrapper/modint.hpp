@@ -14,6 +14,9 @@ namespace pcl {
  * @brief 自動的に剰余をとる整数型。
  * @details 自動的に `MOD` で割ったあまりをキープする。 `MOD` は素数であればよ
  * い (厳密には割り算をする全ての数字と互いに素であればよい) 。
+ * 演算は全て constexpr なので、階乗や 1 の冪根のテーブルをコンパイル時に作
+ * ることもできる。たくさんの数の逆元が欲しいときは、一つずつ割るよりも
+ * batch_inverse() (wrapper/modint_batch.hpp) の方が速い。
  */
 template <ll MOD>
 class modint {
@@ -22,17 +25,17 @@ class modint {
     ll v_;
 
     /// a の逆元を求める。除算で内部的に用いる。
-    static inline ll inv(ll a) {
+    constexpr static ll inv(ll a) {
         return inv_impl(a, MOD);
     }
 
     /// a の逆元を求めるのに内部的に使える。
-    static inline ll inv_impl(ll a, ll m) {
+    constexpr static ll inv_impl(ll a, ll m) {
         return (a == 1 ? 1 : (1 - m * inv_impl(m % a, a)) / a + m);
     }
 
     /// `v_` の値を `0 <= v_ < MOD` にキープする関数。
-    inline void normalize() {
+    constexpr void normalize() {
         // v_ の符号にかかわらず、符号を保ったまま、絶対値だけ剰余をとったよう
         // な挙動をする。これは C++03 までは implementation-defined で、
         // (a/b)*b + a%b = a を満たしさえすればよかった。 C++11 で除算 (a/b)の
@@ -43,31 +46,37 @@ class modint {
     }
 
     template <ll MOD_>
-    friend bool operator==(modint<MOD_> const &a, modint<MOD_> const &b);
+    friend constexpr bool operator==(modint<MOD_> const &a,
+                                     modint<MOD_> const &b);
 
     template <ll MOD_>
-    friend bool operator!=(modint<MOD_> const &a, modint<MOD_> const &b);
+    friend constexpr bool operator!=(modint<MOD_> const &a,
+                                     modint<MOD_> const &b);
 
     template <ll MOD_>
-    friend bool operator<(modint<MOD_> const &a, modint<MOD_> const &b);
+    friend constexpr bool operator<(modint<MOD_> const &a,
+                                    modint<MOD_> const &b);
 
     template <ll MOD_>
-    friend bool operator>(modint<MOD_> const &a, modint<MOD_> const &b);
+    friend constexpr bool operator>(modint<MOD_> const &a,
+                                    modint<MOD_> const &b);
 
     template <ll MOD_>
-    friend bool operator<=(modint<MOD_> const &a, modint<MOD_> const &b);
+    friend constexpr bool operator<=(modint<MOD_> const &a,
+                                     modint<MOD_> const &b);
 
     template <ll MOD_>
-    friend bool operator>=(modint<MOD_> const &a, modint<MOD_> const &b);
+    friend constexpr bool operator>=(modint<MOD_> const &a,
+                                     modint<MOD_> const &b);
 
   public:
     /// デフォルトコンストラクタ
-    modint()
+    constexpr modint()
         : v_(0ll) {
     }
 
     /// コピーコンストラクタ
-    modint(modint const &init)
+    constexpr modint(modint const &init)
         : v_(init.v_) {
     }
 
@@ -77,13 +86,13 @@ class modint {
      * @details 指定された値は勝手に正規化されるため、 `0 <= init < MOD`
      * を満た していなくてもよい。
      */
-    modint(ll init)
+    constexpr modint(ll init)
         : v_(init) {
         normalize();
     }
 
     /// `ll` へのキャスト演算子。
-    explicit operator ll() const {
+    constexpr explicit operator ll() const {
         return v_;
     }
 
@@ -91,31 +100,32 @@ class modint {
      * 破壊的演算 (<> modint)
      */
 
-    modint &operator+=(modint const &o) {
+    constexpr modint &operator+=(modint const &o) {
+        // 両方とも [0, MOD) なので、剰余をとらずに一回引けば十分。
         v_ += o.v_;
-        normalize();
+        if (v_ >= MOD) v_ -= MOD;
         return *this;
     }
 
-    modint &operator-=(modint const &o) {
+    constexpr modint &operator-=(modint const &o) {
         v_ -= o.v_;
-        normalize();
+        if (v_ < 0) v_ += MOD;
         return *this;
     }
 
-    modint &operator*=(modint const &o) {
+    constexpr modint &operator*=(modint const &o) {
         v_ *= o.v_;
         normalize();
         return *this;
     }
 
-    modint &operator/=(modint const &o) {
+    constexpr modint &operator/=(modint const &o) {
         ll i = inv(o.v_);
         *this *= i;
         return *this;
     }
 
-    modint &operator=(modint const &o) {
+    constexpr modint &operator=(modint const &o) {
         v_ = o.v_;
         return *this;
     }
@@ -124,23 +134,23 @@ class modint {
      * 破壊的演算 (<> scalar)
      */
 
-    modint &operator+=(ll o) {
+    constexpr modint &operator+=(ll o) {
         return *this += modint(o);
     }
 
-    modint &operator-=(ll o) {
+    constexpr modint &operator-=(ll o) {
         return *this -= modint(o);
     }
 
-    modint &operator*=(ll o) {
+    constexpr modint &operator*=(ll o) {
         return *this *= modint(o);
     }
 
-    modint &operator/=(ll o) {
+    constexpr modint &operator/=(ll o) {
         return *this /= modint(o);
     }
 
-    modint &operator=(ll o) {
+    constexpr modint &operator=(ll o) {
         return *this = modint(o);
     }
 
@@ -148,13 +158,19 @@ class modint {
      * 単項演算
      */
 
-    modint &operator++() {
+    constexpr modint operator-() const {
+        modint res;
+        res.v_ = v_ == 0 ? 0 : MOD - v_;
+        return res;
+    }
+
+    constexpr modint &operator++() {
         v_++;
         if (v_ == MOD) v_ = 0;
         return *this;
     }
 
-    modint &operator--() {
+    constexpr modint &operator--() {
         if (v_ == 0) v_ = MOD;
         v_--;
         return *this;
@@ -166,32 +182,32 @@ class modint {
  */
 
 template <ll MOD>
-bool operator==(modint<MOD> const &a, modint<MOD> const &b) {
+constexpr bool operator==(modint<MOD> const &a, modint<MOD> const &b) {
     return a.v_ == b.v_;
 }
 
 template <ll MOD>
-bool operator!=(modint<MOD> const &a, modint<MOD> const &b) {
+constexpr bool operator!=(modint<MOD> const &a, modint<MOD> const &b) {
     return !(a == b);
 }
 
 template <ll MOD>
-bool operator<(modint<MOD> const &a, modint<MOD> const &b) {
+constexpr bool operator<(modint<MOD> const &a, modint<MOD> const &b) {
     return a.v_ < b.v_;
 }
 
 template <ll MOD>
-bool operator>(modint<MOD> const &a, modint<MOD> const &b) {
+constexpr bool operator>(modint<MOD> const &a, modint<MOD> const &b) {
     return b < a;
 }
 
 template <ll MOD>
-bool operator<=(modint<MOD> const &a, modint<MOD> const &b) {
+constexpr bool operator<=(modint<MOD> const &a, modint<MOD> const &b) {
     return a < b || a == b;
 }
 
 template <ll MOD>
-bool operator>=(modint<MOD> const &a, modint<MOD> const &b) {
+constexpr bool operator>=(modint<MOD> const &a, modint<MOD> const &b) {
     return b <= a;
 }
 
@@ -200,32 +216,32 @@ bool operator>=(modint<MOD> const &a, modint<MOD> const &b) {
  */
 
 template <ll MOD>
-bool operator==(modint<MOD> const &a, ll b) {
+constexpr bool operator==(modint<MOD> const &a, ll b) {
     return a == modint<MOD>(b);
 }
 
 template <ll MOD>
-bool operator!=(modint<MOD> const &a, ll b) {
+constexpr bool operator!=(modint<MOD> const &a, ll b) {
     return a != modint<MOD>(b);
 }
 
 template <ll MOD>
-bool operator<(modint<MOD> const &a, ll b) {
+constexpr bool operator<(modint<MOD> const &a, ll b) {
     return a < modint<MOD>(b);
 }
 
 template <ll MOD>
-bool operator>(modint<MOD> const &a, ll b) {
+constexpr bool operator>(modint<MOD> const &a, ll b) {
     return a > modint<MOD>(b);
 }
 
 template <ll MOD>
-bool operator<=(modint<MOD> const &a, ll b) {
+constexpr bool operator<=(modint<MOD> const &a, ll b) {
     return a <= modint<MOD>(b);
 }
 
 template <ll MOD>
-bool operator>=(modint<MOD> const &a, ll b) {
+constexpr bool operator>=(modint<MOD> const &a, ll b) {
     return a >= modint<MOD>(b);
 }
 
@@ -234,32 +250,32 @@ bool operator>=(modint<MOD> const &a, ll b) {
  */
 
 template <ll MOD>
-bool operator==(ll a, modint<MOD> const &b) {
+constexpr bool operator==(ll a, modint<MOD> const &b) {
     return modint<MOD>(a) == b;
 }
 
 template <ll MOD>
-bool operator!=(ll a, modint<MOD> const &b) {
+constexpr bool operator!=(ll a, modint<MOD> const &b) {
     return modint<MOD>(a) != b;
 }
 
 template <ll MOD>
-bool operator<(ll a, modint<MOD> const &b) {
+constexpr bool operator<(ll a, modint<MOD> const &b) {
     return modint<MOD>(a) < b;
 }
 
 template <ll MOD>
-bool operator>(ll a, modint<MOD> const &b) {
+constexpr bool operator>(ll a, modint<MOD> const &b) {
     return modint<MOD>(a) > b;
 }
 
 template <ll MOD>
-bool operator<=(ll a, modint<MOD> const &b) {
+constexpr bool operator<=(ll a, modint<MOD> const &b) {
     return modint<MOD>(a) <= b;
 }
 
 template <ll MOD>
-bool operator>=(ll a, modint<MOD> const &b) {
+constexpr bool operator>=(ll a, modint<MOD> const &b) {
     return modint<MOD>(a) >= b;
 }
 
@@ -268,22 +284,22 @@ bool operator>=(ll a, modint<MOD> const &b) {
  */
 
 template <ll MOD>
-modint<MOD> operator+(modint<MOD> a, modint<MOD> const &b) {
+constexpr modint<MOD> operator+(modint<MOD> a, modint<MOD> const &b) {
     return a += b;
 }
 
 template <ll MOD>
-modint<MOD> operator-(modint<MOD> a, modint<MOD> const &b) {
+constexpr modint<MOD> operator-(modint<MOD> a, modint<MOD> const &b) {
     return a -= b;
 }
 
 template <ll MOD>
-modint<MOD> operator*(modint<MOD> a, modint<MOD> const &b) {
+constexpr modint<MOD> operator*(modint<MOD> a, modint<MOD> const &b) {
     return a *= b;
 }
 
 template <ll MOD>
-modint<MOD> operator/(modint<MOD> a, modint<MOD> const &b) {
+constexpr modint<MOD> operator/(modint<MOD> a, modint<MOD> const &b) {
     return a /= b;
 }
 
@@ -292,22 +308,22 @@ modint<MOD> operator/(modint<MOD> a, modint<MOD> const &b) {
  */
 
 template <ll MOD>
-modint<MOD> operator+(modint<MOD> a, ll b) {
+constexpr modint<MOD> operator+(modint<MOD> a, ll b) {
     return a += modint<MOD>(b);
 }
 
 template <ll MOD>
-modint<MOD> operator-(modint<MOD> a, ll b) {
+constexpr modint<MOD> operator-(modint<MOD> a, ll b) {
     return a -= modint<MOD>(b);
 }
 
 template <ll MOD>
-modint<MOD> operator*(modint<MOD> a, ll b) {
+constexpr modint<MOD> operator*(modint<MOD> a, ll b) {
     return a *= modint<MOD>(b);
 }
 
 template <ll MOD>
-modint<MOD> operator/(modint<MOD> a, ll b) {
+constexpr modint<MOD> operator/(modint<MOD> a, ll b) {
     return a /= modint<MOD>(b);
 }
 
@@ -316,22 +332,22 @@ modint<MOD> operator/(modint<MOD> a, ll b) {
  */
 
 template <ll MOD>
-modint<MOD> operator+(ll a, modint<MOD> const &b) {
+constexpr modint<MOD> operator+(ll a, modint<MOD> const &b) {
     return modint<MOD>(a) += b;
 }
 
 template <ll MOD>
-modint<MOD> operator-(ll a, modint<MOD> const &b) {
+constexpr modint<MOD> operator-(ll a, modint<MOD> const &b) {
     return modint<MOD>(a) -= b;
 }
 
 template <ll MOD>
-modint<MOD> operator*(ll a, modint<MOD> const &b) {
+constexpr modint<MOD> operator*(ll a, modint<MOD> const &b) {
     return modint<MOD>(a) *= b;
 }
 
 template <ll MOD>
-modint<MOD> operator/(ll a, modint<MOD> const &b) {
+constexpr modint<MOD> operator/(ll a, modint<MOD> const &b) {
     return modint<MOD>(a) /= b;
 }
 
@@ -0,0 +1,303 @@
+/**
+ * @file wrapper/modint_batch.hpp
+ * @brief modint の配列に対する演算をまとめて行う関数群。
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include "../wrapper/montgomery_modint.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <type_traits>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace pcl {
+
+/*
+ * SIMD 版の実装
+ * *_simd_impl() は先頭から処理できた要素数を返し、残りは呼び出し側がスカ
+ * ラーのループで処理する。一般の型では 0 を返す。
+ */
+
+template <typename T>
+int mul_into_simd_impl(T *, T const *, T const *, int) {
+    return 0;
+}
+
+template <typename T>
+int fma_into_simd_impl(T *, T const *, T const *, int) {
+    return 0;
+}
+
+template <typename T>
+int dot_simd_impl(T &, T const *, T const *, int) {
+    return 0;
+}
+
+template <typename T>
+int prefix_sum_simd_impl(T *, int) {
+    return 0;
+}
+
+template <typename T>
+int horner_simd_impl(T *, std::vector<T> const &, T const *, int) {
+    return 0;
+}
+
+#ifdef __AVX2__
+
+/**
+ * @brief 32 bit の Montgomery 表現 8 個を __m256i で演算する。
+ * @details montgomery_modint<MOD, unsigned> は unsigned 一つだけを持つので、
+ * その配列は unsigned の配列としてそのまま読み書きできる。 MOD < 2^31 なので
+ * 和は 2^32 未満に収まり、 a - MOD が溢れたかどうかを min_epu32 で判定でき
+ * る。
+ */
+template <ll MOD>
+struct montgomery_avx2 {
+    using value_type = montgomery_modint<MOD, unsigned>;
+    static_assert(sizeof(value_type) == sizeof(unsigned) &&
+                      std::is_standard_layout<value_type>::value,
+                  "montgomery_modint must be a plain 32-bit word");
+
+    /// -MOD^{-1} mod 2^32
+    constexpr static unsigned neg_inv_impl() {
+        unsigned x = MOD;
+        for (int i = 0; i < 5; i++) x *= 2u - unsigned(MOD) * x;
+        return -x;
+    }
+
+    static __m256i load(value_type const *p) {
+        return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(p));
+    }
+
+    static void store(value_type *p, __m256i x) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), x);
+    }
+
+    static __m256i broadcast(value_type const &x) {
+        return _mm256_set1_epi32(*reinterpret_cast<unsigned const *>(&x));
+    }
+
+    /// 2 MOD 未満の値を MOD 未満にする。
+    static __m256i shrink(__m256i x) {
+        return _mm256_min_epu32(x,
+                                _mm256_sub_epi32(x, _mm256_set1_epi32(MOD)));
+    }
+
+    static __m256i add(__m256i a, __m256i b) {
+        return shrink(_mm256_add_epi32(a, b));
+    }
+
+    /// 偶数番目の 32 bit に入った 64 bit の積 t を REDC する。
+    static __m256i reduce(__m256i t) {
+        __m256i const m  = _mm256_set1_epi32(MOD);
+        __m256i const ni = _mm256_set1_epi32(neg_inv_impl());
+        __m256i q        = _mm256_mul_epu32(t, ni);
+        return _mm256_srli_epi64(_mm256_add_epi64(t, _mm256_mul_epu32(q, m)),
+                                 32);
+    }
+
+    static __m256i mul(__m256i a, __m256i b) {
+        __m256i even = reduce(_mm256_mul_epu32(a, b));
+        __m256i odd  = reduce(_mm256_mul_epu32(_mm256_srli_epi64(a, 32),
+                                               _mm256_srli_epi64(b, 32)));
+        return shrink(_mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32),
+                                         0b10101010));
+    }
+
+    /// 8 要素の和 (スカラー)
+    static value_type sum(__m256i x) {
+        alignas(32) value_type buf[8];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(buf), x);
+        value_type res = 0;
+        for (auto const &y : buf) res += y;
+        return res;
+    }
+};
+
+template <ll MOD>
+int mul_into_simd_impl(montgomery_modint<MOD, unsigned> *out,
+                       montgomery_modint<MOD, unsigned> const *a,
+                       montgomery_modint<MOD, unsigned> const *b, int n) {
+    using V = montgomery_avx2<MOD>;
+    int i   = 0;
+    for (; i + 8 <= n; i += 8) {
+        V::store(out + i, V::mul(V::load(a + i), V::load(b + i)));
+    }
+    return i;
+}
+
+template <ll MOD>
+int fma_into_simd_impl(montgomery_modint<MOD, unsigned> *out,
+                       montgomery_modint<MOD, unsigned> const *a,
+                       montgomery_modint<MOD, unsigned> const *b, int n) {
+    using V = montgomery_avx2<MOD>;
+    int i   = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i p = V::mul(V::load(a + i), V::load(b + i));
+        V::store(out + i, V::add(V::load(out + i), p));
+    }
+    return i;
+}
+
+template <ll MOD>
+int dot_simd_impl(montgomery_modint<MOD, unsigned> &res,
+                  montgomery_modint<MOD, unsigned> const *a,
+                  montgomery_modint<MOD, unsigned> const *b, int n) {
+    using V     = montgomery_avx2<MOD>;
+    __m256i acc = _mm256_setzero_si256();
+    int i       = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc = V::add(acc, V::mul(V::load(a + i), V::load(b + i)));
+    }
+    res = V::sum(acc);
+    return i;
+}
+
+/**
+ * @details 各 128 bit の中で 1, 2 要素ずらして足して 4 要素ずつの累積和を作
+ * り、下半分の最後を上半分に足す。最後にそれまでの合計を全体に足す。 0 の
+ * Montgomery 表現は 0 なので、ずらして入ってきた 0 は足しても影響しない。
+ */
+template <ll MOD>
+int prefix_sum_simd_impl(montgomery_modint<MOD, unsigned> *a, int n) {
+    using V            = montgomery_avx2<MOD>;
+    __m256i const low  = _mm256_setr_epi32(0, 0, 0, 0, 3, 3, 3, 3);
+    __m256i const last = _mm256_set1_epi32(7);
+    __m256i carry      = _mm256_setzero_si256();
+    int i              = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = V::load(a + i);
+        x         = V::add(x, _mm256_slli_si256(x, 4));
+        x         = V::add(x, _mm256_slli_si256(x, 8));
+        __m256i h = _mm256_permutevar8x32_epi32(x, low);
+        x = V::add(x, _mm256_blend_epi32(_mm256_setzero_si256(), h, 0xf0));
+        x = V::add(x, carry);
+        V::store(a + i, x);
+        carry = _mm256_permutevar8x32_epi32(x, last);
+    }
+    return i;
+}
+
+template <ll MOD>
+int horner_simd_impl(montgomery_modint<MOD, unsigned> *out,
+                     std::vector<montgomery_modint<MOD, unsigned>> const &c,
+                     montgomery_modint<MOD, unsigned> const *x, int n) {
+    using V = montgomery_avx2<MOD>;
+    int i   = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i xs = V::load(x + i), acc = _mm256_setzero_si256();
+        for (int k = static_cast<int>(c.size()) - 1; k >= 0; k--) {
+            acc = V::add(V::mul(acc, xs), V::broadcast(c[k]));
+        }
+        V::store(out + i, acc);
+    }
+    return i;
+}
+
+#endif
+
+/**
+ * @brief out[i] = a[i] * b[i]
+ * @details out は a, b と同じ長さに揃えられる。 out が a や b と同じ配列で
+ * もよい。 T が 32 bit の montgomery_modint で AVX2 が使えるなら 8 要素ずつ
+ * 処理する。そうでなければ (modint や dynamic_modint など) 普通のループにな
+ * る。以下の関数も同様。
+ */
+template <typename T>
+void mul_into(std::vector<T> &out, std::vector<T> const &a,
+              std::vector<T> const &b) {
+    int n = a.size();
+    assert(static_cast<int>(b.size()) == n);
+    out.resize(n);
+    for (int i = mul_into_simd_impl(out.data(), a.data(), b.data(), n);
+         i < n; i++) {
+        out[i] = a[i] * b[i];
+    }
+}
+
+/// out[i] += a[i] * b[i]
+template <typename T>
+void fma_into(std::vector<T> &out, std::vector<T> const &a,
+              std::vector<T> const &b) {
+    int n = a.size();
+    assert(static_cast<int>(b.size()) == n &&
+           static_cast<int>(out.size()) == n);
+    for (int i = fma_into_simd_impl(out.data(), a.data(), b.data(), n);
+         i < n; i++) {
+        out[i] += a[i] * b[i];
+    }
+}
+
+/// Σ a[i] * b[i]
+template <typename T>
+T dot(std::vector<T> const &a, std::vector<T> const &b) {
+    int n = a.size();
+    assert(static_cast<int>(b.size()) == n);
+    T res = 0;
+    for (int i = dot_simd_impl(res, a.data(), b.data(), n); i < n; i++) {
+        res += a[i] * b[i];
+    }
+    return res;
+}
+
+/// a[i] <- a[0] + ... + a[i] (in-place)
+template <typename T>
+void prefix_sum(std::vector<T> &a) {
+    int n = a.size();
+    int i = prefix_sum_simd_impl(a.data(), n);
+    for (i = std::max(i, 1); i < n; i++) a[i] += a[i - 1];
+}
+
+/**
+ * @brief 多項式 c[0] + c[1] x + ... の各点 xs[i] での値を out[i] に入れる。
+ * @details 各点について Horner 法で計算する。 SIMD 版では 8 点を同時に進め
+ * る。計算量は O(|c| |xs|) 。
+ */
+template <typename T>
+void horner_into(std::vector<T> &out, std::vector<T> const &c,
+                 std::vector<T> const &xs) {
+    int n = xs.size();
+    out.resize(n);
+    for (int i = horner_simd_impl(out.data(), c, xs.data(), n); i < n; i++) {
+        T acc = 0;
+        for (int k = static_cast<int>(c.size()) - 1; k >= 0; k--) {
+            acc = acc * xs[i] + c[k];
+        }
+        out[i] = acc;
+    }
+}
+
+/**
+ * @brief a の各要素をその逆元で置き換える (in-place) 。
+ * @details 要素は全て逆元を持たなければならない。 Montgomery の trick によ
+ * り、累積積 p[i] = a[0] ... a[i] の逆元を一回だけ除算で求め、
+ * a[i]^{-1} = p[i]^{-1} p[i-1] 、 p[i-1]^{-1} = p[i]^{-1} a[i] で後ろから
+ * 求める。除算は一回で、残りは 3n 回の乗算になる。
+ */
+template <typename T>
+void batch_inverse(std::vector<T> &a) {
+    int n = a.size();
+    if (n == 0) return;
+    std::vector<T> p(n);
+    p[0] = a[0];
+    for (int i = 1; i < n; i++) p[i] = p[i - 1] * a[i];
+    assert(p[n - 1] != 0);
+
+    T inv = T(1) / p[n - 1];
+    for (int i = n - 1; i > 0; i--) {
+        T x  = a[i];
+        a[i] = inv * p[i - 1];
+        inv *= x;
+    }
+    a[0] = inv;
+}
+
+} // namespace pcl
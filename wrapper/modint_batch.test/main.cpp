@@ -0,0 +1,91 @@
+#include "prelude.hpp"
+
+#include "wrapper/modint.hpp"
+#include "wrapper/modint_batch.hpp"
+#include "wrapper/montgomery_modint.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+constexpr ll MOD = 998244353;
+using M          = montgomery_modint<MOD>;
+
+/// modint (普通のループ) と montgomery_modint (AVX2 があれば SIMD) で同じ計
+/// 算をして、結果が一致するか。
+template <typename F>
+bool check(vector<modint<MOD>> a, vector<M> b, F f) {
+    f(a), f(b);
+    if (a.size() != b.size()) return false;
+    for (int i = 0; i < static_cast<int>(a.size()); i++) {
+        if (static_cast<ll>(a[i]) != static_cast<ll>(b[i])) return false;
+    }
+    return true;
+}
+
+/// コンパイル時に計算できる階乗のテーブル
+struct fact_table {
+    modint<MOD> v[20];
+};
+
+constexpr fact_table factorial_table() {
+    fact_table t{};
+    t.v[0] = 1;
+    for (int i = 1; i < 20; i++) t.v[i] = t.v[i - 1] * i;
+    return t;
+}
+
+int main() {
+    int n;
+    cin >> n;
+    vector<ll> x(n), y(n);
+    mt19937_64 rng(n);
+    for (int i = 0; i < n; i++) x[i] = rng() % MOD, y[i] = rng() % MOD;
+    // 端の値も含める。
+    if (n >= 3) x[0] = 0, x[1] = MOD - 1, y[2] = MOD - 1;
+
+    vector<modint<MOD>> xa(x.begin(), x.end()), ya(y.begin(), y.end());
+    vector<M> xb(x.begin(), x.end()), yb(y.begin(), y.end());
+
+    cout << check(xa, xb, [&](auto &v) {
+        using T = typename std::decay_t<decltype(v)>::value_type;
+        mul_into(v, v, vector<T>(y.begin(), y.end()));
+    }) << endl;
+    cout << check(xa, xb, [&](auto &v) {
+        using T = typename std::decay_t<decltype(v)>::value_type;
+        vector<T> w(y.begin(), y.end());
+        fma_into(v, w, w);
+    }) << endl;
+    cout << check(xa, xb, [&](auto &v) {
+        using T = typename std::decay_t<decltype(v)>::value_type;
+        v       = {dot(v, vector<T>(y.begin(), y.end()))};
+    }) << endl;
+    cout << check(xa, xb, [](auto &v) { prefix_sum(v); }) << endl;
+    cout << check(xa, xb, [&](auto &v) {
+        using T = typename std::decay_t<decltype(v)>::value_type;
+        vector<T> c(y.begin(), y.begin() + min(n, 17));
+        horner_into(v, c, vector<T>(v));
+    }) << endl;
+
+    // 直接の値の確認
+    vector<M> p = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    prefix_sum(p);
+    cout << p << endl;
+    cout << dot(p, p) << endl;
+
+    // まとめて逆元をとると、一つずつ割ったのと一致する。
+    vector<modint<MOD>> inv_a(xa.begin() + 3, xa.end()), inv_b = inv_a;
+    for (auto &v : inv_a) v = 1 / v;
+    batch_inverse(inv_b);
+    cout << (inv_a == inv_b) << endl;
+    vector<M> q = {1, 2, 3, 4, 5};
+    batch_inverse(q);
+    cout << q << endl;
+
+    // コンパイル時に作った階乗のテーブル
+    constexpr auto fact = factorial_table();
+    static_assert(static_cast<ll>(fact.v[10]) == 3628800, "");
+    static_assert(fact.v[19] * 19 != 0 && fact.v[1] == 1, "");
+    cout << fact.v[19] << endl;
+}
@@ -0,0 +1,67 @@
+/// ベンチマーク: montgomery_modint と modint の乗算・加算
+/// 使い方: ./a.out > bench_output.txt
+
+#include "prelude.hpp"
+
+#include "wrapper/modint.hpp"
+#include "wrapper/montgomery_modint.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+/// f() を reps 回実行した中で最短の時間 (秒)
+template <typename F>
+double seconds(F const &f, int reps = 3) {
+    double best = 1e18;
+    for (int r = 0; r < reps; r++) {
+        auto start = chrono::steady_clock::now();
+        f();
+        chrono::duration<double> d = chrono::steady_clock::now() - start;
+        best = min(best, d.count());
+    }
+    return best;
+}
+
+/// 最適化で消されないように結果を捨てる。
+volatile ll sink;
+
+/**
+ * 長さ n の配列に対する要素ごとの積と和 (独立な演算、スループット) と、前の
+ * 結果に依存する積和の連鎖 (レイテンシ) を rounds 回ずつ測る。
+ */
+template <typename T>
+void bench(string const &name, int n = 1 << 20, int rounds = 20) {
+    mt19937_64 rng(1);
+    vector<T> a(n), b(n), c(n);
+    for (auto &x : a) x = static_cast<ll>(rng() >> 2);
+    for (auto &x : b) x = static_cast<ll>(rng() >> 2);
+
+    double mul = seconds([&] {
+        for (int r = 0; r < rounds; r++)
+            for (int i = 0; i < n; i++) c[i] = a[i] * b[i];
+        sink = static_cast<ll>(c[n - 1]);
+    });
+    double add = seconds([&] {
+        for (int r = 0; r < rounds; r++)
+            for (int i = 0; i < n; i++) c[i] = a[i] + b[i] - c[i];
+        sink = static_cast<ll>(c[n - 1]);
+    });
+    double chain = seconds([&] {
+        T x = a[0];
+        for (int r = 0; r < rounds; r++)
+            for (int i = 0; i < n; i++) x = x * a[i] + b[i];
+        sink = static_cast<ll>(x);
+    });
+    printf("%-24s mul %7.4fs add %7.4fs mul-add chain %7.4fs\n",
+           name.c_str(), mul, add, chain);
+}
+
+int main() {
+    bench<modint<P7>>("modint<P7>");
+    bench<montgomery_modint32<P7>>("montgomery_modint32<P7>");
+    bench<montgomery_modint64<P7>>("montgomery_modint64<P7>");
+    bench<modint<998244353>>("modint<998244353>");
+    bench<montgomery_modint32<998244353>>("montgomery32<998244353>");
+}
@@ -0,0 +1,389 @@
+/**
+ * @file wrapper/montgomery_modint.hpp
+ * @brief Montgomery 表現で剰余をとる整数型。
+ */
+#pragma once
+
+#include "../prelude.hpp"
+
+#include "../math/alg.hpp"
+
+#include <iostream>
+#include <type_traits>
+
+namespace pcl {
+
+/**
+ * @brief Montgomery 表現で自動的に剰余をとる整数型。
+ * @details modint と同じように使えるが、値 x を x R mod MOD (R = 2^32 または
+ * 2^64) の形で持つことで、乗算を除算なしの Montgomery reduction (REDC) だけ
+ * で行う。 `MOD` は 2^62 未満の奇数でなければならない (素数である必要はない
+ * が、割り算をする数とは互いに素でなければならない) 。
+ * 内部の語 `U` は MOD < 2^31 なら unsigned (R = 2^32) 、そうでなければ ull
+ * (R = 2^64) を既定とする。加減算は比較と分岐の代わりに、引き算が負になった
+ * ときの最上位ビットから作ったマスクで MOD を足し戻す。
+ */
+template <ll MOD,
+          typename U = typename std::conditional<(MOD < (1ll << 31)),
+                                                 unsigned, ull>::type>
+class montgomery_modint {
+    static_assert(MOD % 2 == 1 && 0 < MOD && MOD < (1ll << 62),
+                  "MOD must be an odd number less than 2^62");
+    static_assert(std::is_same<U, unsigned>::value ||
+                      std::is_same<U, ull>::value,
+                  "U must be unsigned or ull");
+    static_assert(std::is_same<U, ull>::value || MOD < (1ll << 31),
+                  "MOD must be less than 2^31 for 32-bit words");
+
+  public:
+    /// 内部の語の型
+    using word_type = U;
+
+    /// 積を保持する 2 倍幅の型
+    using wide_type =
+        typename std::conditional<std::is_same<U, unsigned>::value, ull,
+                                  __uint128_t>::type;
+
+  private:
+    /// 語のビット数。 R = 2^bits 。
+    constexpr static int bits = 8 * sizeof(U);
+
+    /// -MOD^{-1} mod R 。 Newton 法で 1 ビットから倍々に精度を上げる。
+    constexpr static U neg_inv_impl() {
+        U x = MOD;
+        for (int i = 0; i < 6; i++) x *= U(2) - U(MOD) * x;
+        return -x;
+    }
+
+    /// R^2 mod MOD 。整数を Montgomery 表現に変換するのに使う。
+    constexpr static U r2_impl() {
+        return (-wide_type(MOD)) % wide_type(MOD);
+    }
+
+    constexpr static U neg_inv = neg_inv_impl();
+    constexpr static U r2      = r2_impl();
+
+    /// 値 (Montgomery 表現, 0 <= v_ < MOD)
+    U v_;
+
+    /// t R^{-1} mod MOD を返す (REDC) 。 t < MOD R でなければならない。
+    constexpr static U reduce(wide_type t) {
+        // t + m MOD は R で割り切れ、結果は 2 MOD 未満。
+        U m = U(t) * neg_inv;
+        U r = (t + wide_type(m) * U(MOD)) >> bits;
+        return r >= U(MOD) ? r - U(MOD) : r;
+    }
+
+    /// 符号ビットが立っていれば MOD を足す。
+    constexpr static U fix(U x) {
+        return x + (U(MOD) & (U(0) - (x >> (bits - 1))));
+    }
+
+    template <ll MOD_, typename U_>
+    friend constexpr bool operator==(montgomery_modint<MOD_, U_> const &a,
+                                     montgomery_modint<MOD_, U_> const &b);
+
+  public:
+    /// デフォルトコンストラクタ
+    constexpr montgomery_modint()
+        : v_(0) {
+    }
+
+    /**
+     * @brief 指定された値で初期化するコンストラクタ。
+     * @details 指定された値は勝手に正規化されるため、 `0 <= init < MOD` を満
+     * たしていなくてもよい。
+     */
+    constexpr montgomery_modint(ll init)
+        : v_(0) {
+        init %= MOD;
+        if (init < 0) init += MOD;
+        v_ = reduce(wide_type(init) * r2);
+    }
+
+    /// `ll` へのキャスト演算子。 Montgomery 表現から戻す。
+    constexpr explicit operator ll() const {
+        return reduce(v_);
+    }
+
+    /*
+     * 破壊的演算 (<> montgomery_modint)
+     */
+
+    constexpr montgomery_modint &operator+=(montgomery_modint const &o) {
+        v_ = fix(v_ + o.v_ - U(MOD));
+        return *this;
+    }
+
+    constexpr montgomery_modint &operator-=(montgomery_modint const &o) {
+        v_ = fix(v_ - o.v_);
+        return *this;
+    }
+
+    constexpr montgomery_modint &operator*=(montgomery_modint const &o) {
+        v_ = reduce(wide_type(v_) * o.v_);
+        return *this;
+    }
+
+    constexpr montgomery_modint &operator/=(montgomery_modint const &o) {
+        return *this *= montgomery_modint(inv_mod(static_cast<ll>(o), MOD));
+    }
+
+    /*
+     * 破壊的演算 (<> scalar)
+     */
+
+    constexpr montgomery_modint &operator+=(ll o) {
+        return *this += montgomery_modint(o);
+    }
+
+    constexpr montgomery_modint &operator-=(ll o) {
+        return *this -= montgomery_modint(o);
+    }
+
+    constexpr montgomery_modint &operator*=(ll o) {
+        return *this *= montgomery_modint(o);
+    }
+
+    constexpr montgomery_modint &operator/=(ll o) {
+        return *this /= montgomery_modint(o);
+    }
+
+    /*
+     * 単項演算
+     */
+
+    constexpr montgomery_modint operator-() const {
+        return montgomery_modint() -= *this;
+    }
+
+    constexpr montgomery_modint &operator++() {
+        return *this += montgomery_modint(1);
+    }
+
+    constexpr montgomery_modint &operator--() {
+        return *this -= montgomery_modint(1);
+    }
+};
+
+/*
+ * 二項関係
+ * Montgomery 表現は値と一対一に対応するので、等価比較は表現のまま行う。大小
+ * 比較は表現の順序と値の順序が異なるので、 ll に戻してから行う。
+ */
+
+template <ll MOD, typename U>
+constexpr bool operator==(montgomery_modint<MOD, U> const &a,
+                          montgomery_modint<MOD, U> const &b) {
+    return a.v_ == b.v_;
+}
+
+template <ll MOD, typename U>
+constexpr bool operator!=(montgomery_modint<MOD, U> const &a,
+                          montgomery_modint<MOD, U> const &b) {
+    return !(a == b);
+}
+
+template <ll MOD, typename U>
+constexpr bool operator<(montgomery_modint<MOD, U> const &a,
+                         montgomery_modint<MOD, U> const &b) {
+    return static_cast<ll>(a) < static_cast<ll>(b);
+}
+
+template <ll MOD, typename U>
+constexpr bool operator>(montgomery_modint<MOD, U> const &a,
+                         montgomery_modint<MOD, U> const &b) {
+    return b < a;
+}
+
+template <ll MOD, typename U>
+constexpr bool operator<=(montgomery_modint<MOD, U> const &a,
+                          montgomery_modint<MOD, U> const &b) {
+    return !(b < a);
+}
+
+template <ll MOD, typename U>
+constexpr bool operator>=(montgomery_modint<MOD, U> const &a,
+                          montgomery_modint<MOD, U> const &b) {
+    return !(a < b);
+}
+
+/*
+ * 二項関係 (montgomery_modint <> scalar)
+ */
+
+template <ll MOD, typename U>
+constexpr bool operator==(montgomery_modint<MOD, U> const &a, ll b) {
+    return a == montgomery_modint<MOD, U>(b);
+}
+
+template <ll MOD, typename U>
+constexpr bool operator!=(montgomery_modint<MOD, U> const &a, ll b) {
+    return a != montgomery_modint<MOD, U>(b);
+}
+
+template <ll MOD, typename U>
+constexpr bool operator<(montgomery_modint<MOD, U> const &a, ll b) {
+    return a < montgomery_modint<MOD, U>(b);
+}
+
+template <ll MOD, typename U>
+constexpr bool operator>(montgomery_modint<MOD, U> const &a, ll b) {
+    return a > montgomery_modint<MOD, U>(b);
+}
+
+template <ll MOD, typename U>
+constexpr bool operator<=(montgomery_modint<MOD, U> const &a, ll b) {
+    return a <= montgomery_modint<MOD, U>(b);
+}
+
+template <ll MOD, typename U>
+constexpr bool operator>=(montgomery_modint<MOD, U> const &a, ll b) {
+    return a >= montgomery_modint<MOD, U>(b);
+}
+
+/*
+ * 二項関係 (scalar <> montgomery_modint)
+ */
+
+template <ll MOD, typename U>
+constexpr bool operator==(ll a, montgomery_modint<MOD, U> const &b) {
+    return montgomery_modint<MOD, U>(a) == b;
+}
+
+template <ll MOD, typename U>
+constexpr bool operator!=(ll a, montgomery_modint<MOD, U> const &b) {
+    return montgomery_modint<MOD, U>(a) != b;
+}
+
+template <ll MOD, typename U>
+constexpr bool operator<(ll a, montgomery_modint<MOD, U> const &b) {
+    return montgomery_modint<MOD, U>(a) < b;
+}
+
+template <ll MOD, typename U>
+constexpr bool operator>(ll a, montgomery_modint<MOD, U> const &b) {
+    return montgomery_modint<MOD, U>(a) > b;
+}
+
+template <ll MOD, typename U>
+constexpr bool operator<=(ll a, montgomery_modint<MOD, U> const &b) {
+    return montgomery_modint<MOD, U>(a) <= b;
+}
+
+template <ll MOD, typename U>
+constexpr bool operator>=(ll a, montgomery_modint<MOD, U> const &b) {
+    return montgomery_modint<MOD, U>(a) >= b;
+}
+
+/*
+ * 二項演算
+ */
+
+template <ll MOD, typename U>
+constexpr montgomery_modint<MOD, U>
+operator+(montgomery_modint<MOD, U> a, montgomery_modint<MOD, U> const &b) {
+    return a += b;
+}
+
+template <ll MOD, typename U>
+constexpr montgomery_modint<MOD, U>
+operator-(montgomery_modint<MOD, U> a, montgomery_modint<MOD, U> const &b) {
+    return a -= b;
+}
+
+template <ll MOD, typename U>
+constexpr montgomery_modint<MOD, U>
+operator*(montgomery_modint<MOD, U> a, montgomery_modint<MOD, U> const &b) {
+    return a *= b;
+}
+
+template <ll MOD, typename U>
+constexpr montgomery_modint<MOD, U>
+operator/(montgomery_modint<MOD, U> a, montgomery_modint<MOD, U> const &b) {
+    return a /= b;
+}
+
+template <ll MOD, typename U>
+constexpr montgomery_modint<MOD, U> operator+(montgomery_modint<MOD, U> a,
+                                              ll b) {
+    return a += b;
+}
+
+template <ll MOD, typename U>
+constexpr montgomery_modint<MOD, U> operator-(montgomery_modint<MOD, U> a,
+                                              ll b) {
+    return a -= b;
+}
+
+template <ll MOD, typename U>
+constexpr montgomery_modint<MOD, U> operator*(montgomery_modint<MOD, U> a,
+                                              ll b) {
+    return a *= b;
+}
+
+template <ll MOD, typename U>
+constexpr montgomery_modint<MOD, U> operator/(montgomery_modint<MOD, U> a,
+                                              ll b) {
+    return a /= b;
+}
+
+template <ll MOD, typename U>
+constexpr montgomery_modint<MOD, U>
+operator+(ll a, montgomery_modint<MOD, U> const &b) {
+    return montgomery_modint<MOD, U>(a) += b;
+}
+
+template <ll MOD, typename U>
+constexpr montgomery_modint<MOD, U>
+operator-(ll a, montgomery_modint<MOD, U> const &b) {
+    return montgomery_modint<MOD, U>(a) -= b;
+}
+
+template <ll MOD, typename U>
+constexpr montgomery_modint<MOD, U>
+operator*(ll a, montgomery_modint<MOD, U> const &b) {
+    return montgomery_modint<MOD, U>(a) *= b;
+}
+
+template <ll MOD, typename U>
+constexpr montgomery_modint<MOD, U>
+operator/(ll a, montgomery_modint<MOD, U> const &b) {
+    return montgomery_modint<MOD, U>(a) /= b;
+}
+
+/*
+ * ストリーム入出力
+ */
+
+/// ストリーム出力演算子
+template <ll MOD, typename U>
+std::ostream &operator<<(std::ostream &os,
+                         montgomery_modint<MOD, U> const &x) {
+    return os << static_cast<ll>(x);
+}
+
+/// ストリーム入力演算子
+template <ll MOD, typename U>
+std::istream &operator>>(std::istream &is, montgomery_modint<MOD, U> &x) {
+    ll v;
+    is >> v, x = v;
+    return is;
+}
+
+/*
+ * エイリアス
+ */
+
+/// 32 bit の語を使う Montgomery 表現の modint 。 MOD < 2^31 。
+template <ll MOD>
+using montgomery_modint32 = montgomery_modint<MOD, unsigned>;
+
+/// 64 bit の語を使う Montgomery 表現の modint 。 MOD < 2^62 。
+template <ll MOD>
+using montgomery_modint64 = montgomery_modint<MOD, ull>;
+
+/// P7 (1'000'000'007) を法とする、 mint の Montgomery 版。
+using mont_mint = montgomery_modint<P7>;
+
+} // namespace pcl
@@ -0,0 +1,69 @@
+#include "prelude.hpp"
+
+#include "wrapper/montgomery_modint.hpp"
+
+#include <bits/stdc++.h>
+
+using namespace std;
+using namespace pcl;
+
+// 比較も定数式の中で使える。
+static_assert(mont_mint(3) < mont_mint(5) && mont_mint(-1) > 5 &&
+                  2 <= mont_mint(2) && mont_mint(7) == 7,
+              "");
+
+/// 同じ操作列を ll (mul_mod, inv_mod) と montgomery_modint で行い、結果が一致
+/// するか。 modint は MOD が大きいと乗算で溢れるので参照には使わない。
+template <ll MOD, typename U>
+bool same_as_reference(int n) {
+    using M = montgomery_modint<MOD, U>;
+    mt19937_64 rng(MOD);
+    ll a = 1;
+    M b  = 1;
+    for (int i = 0; i < n; i++) {
+        ll x = static_cast<ll>(rng() >> 2) - (1ll << 60);
+        ll y = (x % MOD + MOD) % MOD;
+        switch (i % 5) {
+        case 0: a = (a + y) % MOD, b += x; break;
+        case 1: a = (a - y + MOD) % MOD, b -= x; break;
+        case 2: a = mul_mod(a, y, MOD), b *= x; break;
+        case 3: a = (MOD - a) % MOD, b = -b; break;
+        case 4:
+            if (a == MOD - 1) break;
+            a = mul_mod(a, inv_mod(a + 1, MOD), MOD), b /= b + 1;
+        }
+        if (a != static_cast<ll>(b)) return false;
+    }
+    return true;
+}
+
+int main() {
+    using M = montgomery_modint<5>;
+    M x, y;
+    cin >> x >> y;
+    cout << x + y << ' ' << x - y << ' ' << x * y << ' ' << x / y << endl;
+    cout << 2ll + y << ' ' << 2ll - y << ' ' << 2ll * y << ' ' << 2ll / y
+         << endl;
+    cout << y + 2ll << ' ' << y - 2ll << ' ' << y * 2ll << ' ' << y / 2ll
+         << endl;
+    cout << (x == y) << (x != y) << (x < y) << (x <= y) << (x > y)
+         << (x >= y) << endl;
+    // mint と同じく ll とも大小比較できる。
+    cout << (x < 4ll) << (x > 4ll) << (x <= 3ll) << (x >= 4ll) << (4ll < x)
+         << (4ll > x) << (3ll <= x) << (3ll >= x) << endl;
+    cout << -x << ' ' << ++x << ' ' << --y << endl;
+
+    cout << same_as_reference<998244353, unsigned>(100000) << endl;
+    cout << same_as_reference<P7, unsigned>(100000) << endl;
+    cout << same_as_reference<P7, ull>(100000) << endl;
+    cout << same_as_reference<(1ll << 61) - 1, ull>(100000) << endl;
+
+    // 素数でない法でも加減乗算はできる。
+    constexpr ll big = (1ll << 62) - 1;
+    montgomery_modint64<big> p = big - 1, q = 3;
+    cout << p * p << ' ' << p + p << ' ' << q - p << endl;
+
+    constexpr mont_mint c = mont_mint(3) * mont_mint(P7 - 1) + 5;
+    static_assert(static_cast<ll>(c) == 2, "");
+    cout << c << endl;
+}